@@ -8,12 +8,41 @@
 #ifndef ARRARY
 #define ARRARY
 
+#if (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L) || __cplusplus >= 202002L
+#define ARRARY_HAS_CONTIGUOUS_ITERATOR
+#endif
+
 #include <algorithm>
+#include <atomic>
 #include <iostream>
-#include <xutility>
-#include <allocators>
-
-#define OVERRIDE
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+//飺԰汾׳std::out_of_rangeNDEBUGʱ
+//MSVC׼_DEBUG_ERRORΪһ
+#ifdef NDEBUG
+#define ARRARY_DEBUG_ERROR(mesg) ((void)0)
+#else
+#define ARRARY_DEBUG_ERROR(mesg) throw std::out_of_range(mesg)
+#endif
+
+//ָ߱벻صڲѭܷ
+#if defined(_MSC_VER) || defined(__GNUC__) || defined(__clang__)
+#define ARRARY_RESTRICT __restrict
+#else
+#define ARRARY_RESTRICT
+#endif
 
 namespace arr
 {
@@ -26,17 +55,109 @@ namespace arr
 	using std::ptrdiff_t;
 	using std::false_type;
 	using std::true_type;
-	using std::is_pod;
+	using std::is_trivially_destructible;
+	using std::is_trivially_copyable;
+	using std::allocator_traits;
 	using std::pair;
 	using std::reverse_iterator;
 
+	using std::is_integral;
+	using std::is_enum;
+	using std::is_floating_point;
+	using std::integral_constant;
+
+	//ǣforEachRowBlockķֿ鲢йԪأпҳ״η(first touch)
+	//̷߳ڸ߳ڵNUMAڵ
+	struct first_touch_t { };
+	const first_touch_t first_touch = first_touch_t();
+
+	//ǣԪɺf(row, col)forEachRowBlockп鲢й
+	//fڶ߳ͬʱã̰߳ȫ
+	struct from_generator_t { };
+	const from_generator_t from_generator = from_generator_t();
+
+	//ǣֱʹⲿֻ(ӳĹڴ)ҲԪ
+	//һʧʱreleaseκд֮ǰȸƵ˽ڴ
+	struct external_buffer_t { };
+	const external_buffer_t external_buffer = external_buffer_t();
+
+	//[0, rows)Ӳֳ̬߳п飬iɵi̴߳
+	//Linuxµi߳ڿʼǰԼڱ̿CPU(sched_getaffinity)ĵiϣ
+	//ͬ״ÿηֿ鶼ͬ
+	//first_touch飬ñʱʵĶǱڴ
+	//rows * rowCost(ÿеԪ)̫Сʱֱڵ߳ϴִ
+	//f(rowBegin, rowEnd, blockIndex)κһ׳쳣߳̽׳
+	template<class _Fn>
+	void forEachRowBlock(size_t rows, size_t rowCost, _Fn f)
+	{
+		size_t parts = std::thread::hardware_concurrency();
+		if (parts == 0)
+			parts = 1;
+		if (parts > rows)
+			parts = rows;
+		if (parts <= 1 || rows * rowCost < (size_t(1) << 16))
+		{
+			f(size_t(0), rows, size_t(0));
+			return;
+		}
+
+		//CPUıţòʱ
+		std::vector<int> cpus;
+#if defined(__linux__)
+		cpu_set_t allowed;
+		CPU_ZERO(&allowed);
+		if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0)
+			for (int c = 0; c != CPU_SETSIZE; c++)
+				if (CPU_ISSET(c, &allowed))
+					cpus.push_back(c);
+#endif
+
+		std::vector<std::thread> workers;
+		std::vector<std::exception_ptr> errors(parts);
+		workers.reserve(parts);
+		for (size_t i = 0; i != parts; i++)
+		{
+			size_t first = rows * i / parts, last = rows * (i + 1) / parts;
+			workers.push_back(std::thread([&f, &errors, &cpus, first, last, i]()
+			{
+#if defined(__linux__)
+				//Ȱٸɻfirst_touchҳŻڰ󶨺Ľڵ
+				if (!cpus.empty())
+				{
+					cpu_set_t mine;
+					CPU_ZERO(&mine);
+					CPU_SET(cpus[i % cpus.size()], &mine);
+					pthread_setaffinity_np(pthread_self(), sizeof(mine), &mine);
+				}
+#endif
+				try
+				{
+					f(first, last, i);
+				}
+				catch (...)
+				{
+					errors[i] = std::current_exception();
+				}
+			}));
+		}
+		for (size_t i = 0; i != parts; i++)
+			workers[i].join();
+		for (size_t i = 0; i != parts; i++)
+			if (errors[i])
+				std::rethrow_exception(errors[i]);
+	}
+
 	//Array2D
+	//ԪţC++20Ϊcontiguous_iteratorSTL㷨ֱmemmove/memcmp
 	template<typename _Elem>
 	class Array2D_Const_Iterator
 	{
 	public:
 		typedef Array2D_Const_Iterator<_Elem> _Myiter;
 		typedef random_access_iterator_tag iterator_category;
+#ifdef ARRARY_HAS_CONTIGUOUS_ITERATOR
+		typedef std::contiguous_iterator_tag iterator_concept;
+#endif
 		typedef _Elem value_type;
 		typedef ptrdiff_t difference_type;
 		typedef const _Elem & reference;
@@ -60,6 +181,11 @@ namespace arr
 			return _ptr; 
 		}
 
+		reference operator[](difference_type _off)const
+		{
+			return _ptr[_off];
+		}
+
 		_Myiter &operator++()
 		{
 			_ptr++;
@@ -104,6 +230,11 @@ namespace arr
 			return tmp += _off;
 		}
 
+		friend _Myiter operator+(difference_type _off, const _Myiter &rhs)
+		{
+			return rhs + _off;
+		}
+
 		_Myiter operator-(difference_type _off)const
 		{
 			_Myiter tmp = *this;
@@ -115,32 +246,32 @@ namespace arr
 			return _ptr - rhs._ptr;
 		}
 
-		bool operator==(const _Myiter &rhs)
+		bool operator==(const _Myiter &rhs)const
 		{
 			return _ptr == rhs._ptr;
 		}
 
-		bool operator!=(const _Myiter &rhs)
+		bool operator!=(const _Myiter &rhs)const
 		{
 			return !(_ptr == rhs._ptr);
 		}
 
-		bool operator<(const _Myiter &rhs)
+		bool operator<(const _Myiter &rhs)const
 		{
 			return _ptr < rhs._ptr;
 		}
 
-		bool operator>(const _Myiter &rhs)
+		bool operator>(const _Myiter &rhs)const
 		{
 			return rhs < *this;
 		}
 
-		bool operator<=(const _Myiter &rhs)
+		bool operator<=(const _Myiter &rhs)const
 		{
 			return !(rhs < *this);
 		}
 
-		bool operator>=(const _Myiter &rhs)
+		bool operator>=(const _Myiter &rhs)const
 		{
 			return !(*this < rhs);
 		}
@@ -156,13 +287,16 @@ namespace arr
 		typedef Array2D_Iterator<_Elem> _Myiter;
 		typedef Array2D_Const_Iterator<_Elem> _Mybase;
 		typedef random_access_iterator_tag iterator_category;
+#ifdef ARRARY_HAS_CONTIGUOUS_ITERATOR
+		typedef std::contiguous_iterator_tag iterator_concept;
+#endif
 		typedef _Elem value_type;
 		typedef ptrdiff_t difference_type;
 		typedef _Elem & reference;
 		typedef _Elem * pointer;
 
 		Array2D_Iterator()
-			:_ptr(0)
+			:_Mybase()
 		{ }
 
 		Array2D_Iterator(pointer ptr)
@@ -171,12 +305,17 @@ namespace arr
 
 		reference operator*() const
 		{ 
-			return ((reference)* *(_Mybase *)this); 
+			return *operator->(); 
 		}
 
 		pointer operator->()const
 		{ 
-			return (pointer)_ptr; 
+			return const_cast<pointer>(this->_ptr); 
+		}
+
+		reference operator[](difference_type _off)const
+		{
+			return operator->()[_off];
 		}
 
 		_Myiter &operator++()
@@ -202,7 +341,7 @@ namespace arr
 		{
 			_Myiter tmp = *this;
 			--(*this);
-			return *this;
+			return tmp;
 		}
 
 		_Myiter &operator+=(difference_type _off)
@@ -222,6 +361,108 @@ namespace arr
 			return tmp += _off;
 		}
 
+		friend _Myiter operator+(difference_type _off, const _Myiter &rhs)
+		{
+			return rhs + _off;
+		}
+
+		_Myiter operator-(difference_type _off)const
+		{
+			_Myiter tmp = *this;
+			return tmp -= _off;
+		}
+
+		difference_type operator-(const _Mybase &rhs)const
+		{
+			return static_cast<const _Mybase &>(*this) - rhs;
+		}
+	};
+
+	//еÿƶһУ_TyconstʱΪֻ
+	//ָкţֻڽʱַβԽĩβ
+	template<typename _Ty>
+	class Array2D_Column_Iterator
+	{
+	public:
+		typedef Array2D_Column_Iterator<_Ty> _Myiter;
+		typedef random_access_iterator_tag iterator_category;
+		typedef typename std::remove_const<_Ty>::type value_type;
+		typedef ptrdiff_t difference_type;
+		typedef _Ty & reference;
+		typedef _Ty * pointer;
+
+		Array2D_Column_Iterator()
+			:_base(0), _stride(0), _row(0)
+		{ }
+
+		Array2D_Column_Iterator(pointer base, difference_type stride, difference_type row = 0)
+			:_base(base), _stride(stride), _row(row)
+		{ }
+
+		reference operator*()const
+		{
+			return _base[_row * _stride];
+		}
+
+		pointer operator->()const
+		{
+			return _base + _row * _stride;
+		}
+
+		reference operator[](difference_type _off)const
+		{
+			return _base[(_row + _off) * _stride];
+		}
+
+		_Myiter &operator++()
+		{
+			++_row;
+			return *this;
+		}
+
+		_Myiter operator++(int)
+		{
+			_Myiter tmp = *this;
+			++(*this);
+			return tmp;
+		}
+
+		_Myiter &operator--()
+		{
+			--_row;
+			return *this;
+		}
+
+		_Myiter operator--(int)
+		{
+			_Myiter tmp = *this;
+			--(*this);
+			return tmp;
+		}
+
+		_Myiter &operator+=(difference_type _off)
+		{
+			_row += _off;
+			return *this;
+		}
+
+		_Myiter &operator-=(difference_type _off)
+		{
+			_row -= _off;
+			return *this;
+		}
+
+		_Myiter operator+(difference_type _off)const
+		{
+			_Myiter tmp = *this;
+			return tmp += _off;
+		}
+
+		friend _Myiter operator+(difference_type _off, const _Myiter &rhs)
+		{
+			return rhs + _off;
+		}
+
 		_Myiter operator-(difference_type _off)const
 		{
 			_Myiter tmp = *this;
@@ -230,8 +471,71 @@ namespace arr
 
 		difference_type operator-(const _Myiter &rhs)const
 		{
-			return *(_Mybase *)this - rhs;
+			return _row - rhs._row;
+		}
+
+		bool operator==(const _Myiter &rhs)const
+		{
+			return _row == rhs._row;
+		}
+
+		bool operator!=(const _Myiter &rhs)const
+		{
+			return !(_row == rhs._row);
+		}
+
+		bool operator<(const _Myiter &rhs)const
+		{
+			return _row < rhs._row;
+		}
+
+		bool operator>(const _Myiter &rhs)const
+		{
+			return rhs < *this;
+		}
+
+		bool operator<=(const _Myiter &rhs)const
+		{
+			return !(rhs < *this);
+		}
+
+		bool operator>=(const _Myiter &rhs)const
+		{
+			return !(*this < rhs);
 		}
+	private:
+		pointer _base;
+		difference_type _stride;
+		difference_type _row;
+	};
+
+	//һԵɵ䣬кеͼֱڷΧforSTL㷨
+	template<typename _Iter>
+	class Array2D_Range
+	{
+	public:
+		typedef _Iter iterator;
+		typedef typename iterator_traits<_Iter>::value_type value_type;
+		typedef typename iterator_traits<_Iter>::reference reference;
+
+		Array2D_Range(_Iter first, _Iter last)
+			:_first(first), _last(last)
+		{ }
+
+		_Iter begin() const { return _first; }
+
+		_Iter end() const { return _last; }
+
+		size_t size() const { return static_cast<size_t>(_last - _first); }
+
+		reference operator[](size_t index) const
+		{
+			if (index >= size())
+				ARRARY_DEBUG_ERROR("index out of range!");
+			return _first[static_cast<ptrdiff_t>(index)];
+		}
+	private:
+		_Iter _first, _last;
 	};
 
 	//дʱƹܶ
@@ -241,10 +545,10 @@ namespace arr
 	public:
 		typedef _RCObject<_Vec> _Myt;
 		_RCObject()
-			:_refCount(0), _shareable(true) { }
+			:_refCount(0), _shareable(true), _readOnly(false) { }
 
 		_RCObject(const _Myt &)
-			:_refCount(0), _shareable(true) { }
+			:_refCount(0), _shareable(true), _readOnly(false) { }
 
 		_Myt &operator=(const _Myt &)
 		{
@@ -256,10 +560,11 @@ namespace arr
 			_refCount++;
 		}
 
+		//_Vec౾(CRTP)̬ɾҪ
 		void decRef()
 		{
 			if (--_refCount == 0)
-				delete this;
+				delete static_cast<_Vec *>(this);
 		}
 
 		void markUnshareable()
@@ -272,22 +577,36 @@ namespace arr
 			return _shareable;
 		}
 
+		//ֻĶ(ӳĹڴ)κд֮ǰmakeCopyü޹
+		void markReadOnly()
+		{
+			_readOnly = true;
+		}
+
+		bool isReadOnly() const
+		{
+			return _readOnly;
+		}
+
 		bool isShared() const
 		{
 			return _refCount > 1;
 		}
 
-		virtual ~_RCObject() = 0 { }
-
 		void swap(_Myt &rhs)throw()
 		{
 			using std::swap;
 			swap(_refCount, rhs._refCount);
 			swap(_shareable, rhs._shareable);
+			swap(_readOnly, rhs._readOnly);
 		}
+	protected:
+		//ֻͨ
+		~_RCObject() { }
 	private:
 		size_t _refCount;
 		bool _shareable;
+		bool _readOnly;
 	};
 
 	//_RCObjectʹγɴдʱƵָ
@@ -348,12 +667,12 @@ namespace arr
 
 		const _Ty &operator*() const
 		{
-			return _rawPtr;
+			return *_rawPtr;
 		}
 
 		void swap(_Myt &rhs)throw()
 		{
-			_rawPtr.swap(rhs._rawPtr);
+			std::swap(_rawPtr, rhs._rawPtr);
 		}
 
 		_Ty *get()const
@@ -382,19 +701,77 @@ namespace arr
 			_rawPtr->addRef();
 		}
 
+		//ȸٷŵɵģֻü1decRef
 		void _makeCopy()
 		{
-			if (_rawPtr->isShared())
+			if (_rawPtr->isShared() || _rawPtr->isReadOnly())
 			{
-				_Ty *old = _rawPtr;
+				_Ty *copy = new _Ty(*_rawPtr);
 				_rawPtr->decRef();
-				_rawPtr = new _Ty(*old);
+				_rawPtr = copy;
 				_rawPtr->addRef();
 			}
 		}
 		_Ty *_rawPtr;
 	};
 
+	//ݹϣȵݱȻõͬĹϣ
+	//öֱȡֵȰ-0.00.0ȡλģʽstd::hash
+	template<class _Elem>
+	struct _HashKind
+		: integral_constant<int,
+			(is_integral<_Elem>::value || is_enum<_Elem>::value) ? 0
+			: (is_floating_point<_Elem>::value && sizeof(_Elem) <= 8) ? 1 : 2>
+	{
+	};
+
+	template<class _Elem>
+	inline unsigned long long _hashWord(const _Elem &x, integral_constant<int, 0>)
+	{
+		return static_cast<unsigned long long>(x);
+	}
+
+	template<class _Elem>
+	inline unsigned long long _hashWord(const _Elem &x, integral_constant<int, 1>)
+	{
+		_Elem y = x + _Elem(0);
+		unsigned long long bits = 0;
+		std::memcpy(&bits, &y, sizeof(y));
+		return bits;
+	}
+
+	template<class _Elem>
+	inline unsigned long long _hashWord(const _Elem &x, integral_constant<int, 2>)
+	{
+		return std::hash<_Elem>()(x);
+	}
+
+	inline unsigned long long _hashMix(unsigned long long a)
+	{
+		a *= 0x9e3779b97f4a7c15ULL;
+		return a ^ (a >> 32);
+	}
+
+	//·ۼӣ·֮û˷ӳٿԻص
+	//64λ˷AVX2ûжӦָѭִ
+	template<class _Elem>
+	size_t _hashRange(const _Elem *p, size_t n)
+	{
+		typedef integral_constant<int, _HashKind<_Elem>::value> _Kind;
+		unsigned long long acc[4] = { 0xcbf29ce484222325ULL, 0x84222325cbf29ce4ULL,
+			0x165667b19e3779f9ULL, 0x27d4eb2f165667c5ULL };
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+			for (size_t k = 0; k != 4; k++)
+				acc[k] = _hashMix(acc[k] ^ _hashWord(p[i + k], _Kind()));
+		for (; i != n; i++)
+			acc[i & 3] = _hashMix(acc[i & 3] ^ _hashWord(p[i], _Kind()));
+		unsigned long long h = n;
+		for (size_t k = 0; k != 4; k++)
+			h = _hashMix(h ^ _hashMix(acc[k]));
+		return static_cast<size_t>(h);
+	}
+
 	//C++άʵ֣Ƕֻ࣬ṩ±
 	//Array2DΪʽ
 	template<typename _Elem,
@@ -402,12 +779,11 @@ namespace arr
 		class Array2D
 	{
 	public:
-		template<typename _Elem>
 		class _Array1D
 		{
-			typedef _Array1D<_Elem> _Myt;
+			typedef _Array1D _Myt;
 			typedef Array2D<_Elem, _Alloc> _MyVec;
-			friend class _MyVec;
+			friend _MyVec;
 
 			typedef random_access_iterator_tag iterator_category;
 			typedef typename _MyVec::value_type value_type;
@@ -416,7 +792,7 @@ namespace arr
 			typedef _Elem * pointer;
 			typedef const _Elem *const_pointer;
 			typedef _Elem & reference;
-			typedef const reference const_reference;
+			typedef const _Elem & const_reference;
 		public:
 			_Elem &operator[](size_type index)
 			{
@@ -425,8 +801,8 @@ namespace arr
 
 			const _Elem &operator[](size_type index) const
 			{
-				if (index >= _sz || index < 0)
-					_DEBUG_ERROR("row out of range!");
+				if (index >= _sz)
+					ARRARY_DEBUG_ERROR("row out of range!");
 				return this->_ptr[index];
 			}
 		private:
@@ -445,37 +821,106 @@ namespace arr
 			}
 		};
 
-		template<typename _Elem, typename _Alloc>
 		struct _ElementValue :
-			public _RCObject<_ElementValue<_Elem, _Alloc> >
+			public _RCObject<_ElementValue>
 		{
-			typedef _ElementValue<_Elem, _Alloc> _Myt;
-			typedef _RCObject<_ElementValue<_Elem, _Alloc> > _Base;
+			typedef _ElementValue _Myt;
+			typedef _RCObject<_ElementValue> _Base;
+			typedef allocator_traits<_Alloc> _Traits;
 			typedef _Alloc allocator_type;
 
 			_ElementValue(size_t h, size_t w)
-				:_h(h), _w(w)
+				:_h(h), _w(w), _firstTouch(false), _hash(0), _hashValid(false)
+			{
+				_init(h, w);
+			}
+
+			//п鲢й죬ҳڹ߳ڵĽڵ
+			_ElementValue(size_t h, size_t w, first_touch_t, const _Elem &value)
+				:_h(h), _w(w), _firstTouch(true), _hash(0), _hashValid(false)
 			{
 				_init(h, w);
+				_parallelConstruct([&value](_Elem *first, _Elem *last, size_t)
+				{
+					std::uninitialized_fill(first, last, value);
+				});
+			}
+
+			//п鲢еf(row, col)죬÷ʽfirst_touchͬ
+			template<class _Fn>
+			_ElementValue(size_t h, size_t w, from_generator_t, const _Fn &f)
+				:_h(h), _w(w), _firstTouch(true), _hash(0), _hashValid(false)
+			{
+				_init(h, w);
+				_Elem *pdata = _memCenter.second;
+				allocator_type _alloc = _memCenter.first;
+				_parallelConstruct([&f, pdata, w, _alloc](_Elem *first, _Elem *last, size_t) mutable
+				{
+					//пǴ׿ʼʼֻһΣ֮Сѭ
+					_Elem *p = first;
+					try
+					{
+						for (size_t i = (first - pdata) / w; p != last; i++)
+							for (size_t j = 0; j != w; j++, p++)
+								_Traits::construct(_alloc, p, f(i, j));
+					}
+					catch (...)
+					{
+						for (; p != first; )
+							_Traits::destroy(_alloc, --p);
+						throw;
+					}
+				});
+			}
+
+			//ڱˣֻдԪر԰ֽڸ
+			_ElementValue(size_t h, size_t w, external_buffer_t, const _Elem *p,
+				const std::function<void()> &release)
+				:_h(h), _w(w), _firstTouch(false), _hash(0), _hashValid(false), _release(release)
+			{
+				static_assert(is_trivially_copyable<_Elem>::value,
+					"external buffers only support trivially copyable elements");
+				if (h == 0 || w == 0)
+					ARRARY_DEBUG_ERROR("dimension can not be zero!");
+				_memCenter.second = const_cast<_Elem *>(p);
+				this->markReadOnly();
+			}
+
+			//һֵuninitialized_fillͻֱӱmemsetѭ
+			_ElementValue(size_t h, size_t w, const _Elem &value)
+				: _h(h), _w(w), _firstTouch(false), _hash(0), _hashValid(false)
+			{
+				_init(h, w);
+				try
+				{
+					std::uninitialized_fill(_memCenter.second, _memCenter.second + _h * _w, value);
+				}
+				catch (...)
+				{
+					_memCenter.first.deallocate(_memCenter.second, _h * _w);
+					throw;
+				}
 			}
 
 			template<typename... _Args>
 			//Ӧдuniverse varģC++98ֵ֧ίһ°
 			_ElementValue(size_t h, size_t w, const _Args &... rest)
-				: _h(h), _w(w)
+				: _h(h), _w(w), _firstTouch(false), _hash(0), _hashValid(false)
 			{
 				_init(h, w);
 
+				_Elem *_pdata = _memCenter.second;
+				allocator_type _alloc = _memCenter.first;
 				try
 				{
-					_Elem *_pdata = _memCenter.second;
-					allocator_type _alloc = _memCenter.first;
 					size_t len = h*w;
-					for (size_t i = 0; i != len; i++)
-						_alloc.construct(_pdata++, rest...);
+					for (size_t i = 0; i != len; i++, _pdata++)
+						_Traits::construct(_alloc, _pdata, rest...);
 				}
 				catch (...)
 				{
+					for (; _pdata != _memCenter.second; )
+						_Traits::destroy(_alloc, --_pdata);
 					_memCenter.first.deallocate(_memCenter.second, _h * _w);
 					throw;
 				}
@@ -483,7 +928,7 @@ namespace arr
 
 			template<class _Iter>
 			_ElementValue(size_t h, size_t w, _Iter first, _Iter last)
-				:_h(h), _w(w)
+				:_h(h), _w(w), _firstTouch(false), _hash(0), _hashValid(false)
 			{
 				_init(h, w);
 				try
@@ -499,9 +944,26 @@ namespace arr
 			}
 
 			_ElementValue(const _Myt &rhs)
-				:_Base(rhs), _h(rhs._h), _w(rhs._w)
+				:_Base(rhs), _h(rhs._h), _w(rhs._w), _firstTouch(rhs._firstTouch),
+				_hash(0), _hashValid(false)
 			{
+				if (rhs.hasCachedHash())
+				{
+					_hash.store(rhs._hash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+					_hashValid.store(true, std::memory_order_relaxed);
+				}
 				_init(_h, _w);
+				//makeCopyĸԭķ÷ʽ
+				if (_firstTouch)
+				{
+					const _Elem *src = rhs._memCenter.second;
+					_Elem *dst = _memCenter.second;
+					_parallelConstruct([src, dst](_Elem *first, _Elem *last, size_t)
+					{
+						uninitialized_copy(src + (first - dst), src + (last - dst), first);
+					});
+					return;
+				}
 				try
 				{
 					_Elem *pdata = rhs._memCenter.second;
@@ -514,15 +976,15 @@ namespace arr
 				}
 			}
 
-			~_ElementValue()OVERRIDE
+			~_ElementValue()
 			{
 				//never throw
 				try
 				{
-					allocator_type _alloc = _memCenter.first;
-					_Elem *_pdata = _memCenter.second;
-
-					_clear(is_pod<_Elem>::type());
+					if (_release)
+						_release();
+					else
+						_clear(typename is_trivially_destructible<_Elem>::type());
 				}
 				catch (...) {}
 			}
@@ -533,7 +995,7 @@ namespace arr
 				allocator_type _alloc = _memCenter.first;
 				_Elem *p = _pdata, *end = _pdata + _h*_w;
 				for (; p != end; p++)
-					_alloc.destroy(p);
+					_Traits::destroy(_alloc, p);
 				_alloc.deallocate(_pdata, _h*_w);
 			}
 
@@ -547,7 +1009,8 @@ namespace arr
 			template<class _Iter>
 			void _input(_Iter first, _Iter last)
 			{
-				_input1(first, last, is_pod<_Elem>::type());
+				_hashValid.store(false, std::memory_order_relaxed);
+				_input1(first, last, typename is_trivially_destructible<_Elem>::type());
 			}
 
 			_Elem *ptr()const
@@ -555,6 +1018,34 @@ namespace arr
 				return _memCenter.second;
 			}
 
+			//ݹϣֻڿɹʱŻ
+			//ɹ˵ܻſдûÿζҪ¼
+			//߳̿ͬʱͬһϣд_hashreleaseλһacquire
+			size_t hashValue() const
+			{
+				if (hasCachedHash())
+					return _hash.load(std::memory_order_relaxed);
+				size_t h = _hashRange(_memCenter.second, _h * _w);
+				if (this->isSharedable())
+				{
+					_hash.store(h, std::memory_order_relaxed);
+					_hashValid.store(true, std::memory_order_release);
+				}
+				return h;
+			}
+
+			bool hasCachedHash() const
+			{
+				return this->isSharedable() && _hashValid.load(std::memory_order_acquire);
+			}
+
+			//д֮ǰãĹϣ
+			_Elem *_writablePtr()
+			{
+				_hashValid.store(false, std::memory_order_relaxed);
+				return _memCenter.second;
+			}
+
 			size_t size()const 
 			{
 				return _h*_w;
@@ -562,7 +1053,40 @@ namespace arr
 
 			pair<_Alloc, _Elem *> _memCenter;
 			size_t _h, _w;
+			bool _firstTouch;
+			mutable std::atomic<size_t> _hash;
+			mutable std::atomic<bool> _hashValid;
+			//ⲿͷźԼĻΪգmakeCopyĸҲΪ
+			std::function<void()> _release;
 		private:
+			//forEachRowBlockķֿ鹹Ԫأfn(first, last, blockIndex)[first, last)
+			//ĳһʧʱѾĿ飬ͷڴ׳
+			template<class _Fn>
+			void _parallelConstruct(_Fn fn)
+			{
+				_Elem *pdata = _memCenter.second;
+				size_t w = _w;
+				std::vector<pair<size_t, size_t> > done;
+				done.resize(std::thread::hardware_concurrency() + 1);
+				try
+				{
+					forEachRowBlock(_h, _w, [&](size_t first, size_t last, size_t block)
+					{
+						fn(pdata + first * w, pdata + last * w, block);
+						done[block] = pair<size_t, size_t>(first, last);
+					});
+				}
+				catch (...)
+				{
+					allocator_type _alloc = _memCenter.first;
+					for (size_t i = 0; i != done.size(); i++)
+						for (size_t k = done[i].first * w; k != done[i].second * w; k++)
+							_Traits::destroy(_alloc, pdata + k);
+					_alloc.deallocate(pdata, _h * _w);
+					throw;
+				}
+			}
+
 			template<class _Iter>
 			void _input1(_Iter first, _Iter last, false_type)
 			{
@@ -571,7 +1095,7 @@ namespace arr
 
 				_Elem *p = _pdata, *end = _pdata + _h*_w;
 				for (; p != end; p++)
-					_alloc.destroy(p);
+					_Traits::destroy(_alloc, p);
 
 				uninitialized_copy(first, last, _pdata);
 			}
@@ -584,26 +1108,18 @@ namespace arr
 				uninitialized_copy(first, last, _pdata);
 			}
 
+			//ʧʱʲôûõ쳣ֱ׸캯ĵ
 			void _init(size_t h, size_t w)
 			{
 				if (h == 0 || w == 0)
-					_DEBUG_ERROR("dimension can not be zero!");
-				try
-				{
-					allocator_type _alloc;
-					_memCenter.first = _alloc;
-					_Elem *_pdata = _alloc.allocate(_h * _w);
-					_memCenter.second = _pdata;
-				}
-				catch (...)
-				{
-					_memCenter.first.deallocate(_memCenter.second, _h * _w);
-					throw;
-				}
+					ARRARY_DEBUG_ERROR("dimension can not be zero!");
+				allocator_type _alloc;
+				_memCenter.first = _alloc;
+				_memCenter.second = _alloc.allocate(_h * _w);
 			}
 		};
 
-		typedef _Array1D<_Elem> _InnerArray;
+		typedef _Array1D _InnerArray;
 		typedef _Elem value_type;
 		typedef size_t size_type;
 		typedef ptrdiff_t difference_type;
@@ -613,9 +1129,15 @@ namespace arr
 		typedef Array2D_Const_Iterator<_Elem> const_iterator;
 		typedef std::reverse_iterator<iterator> reverse_iterator;
 		typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+		typedef Array2D_Column_Iterator<_Elem> column_iterator;
+		typedef Array2D_Column_Iterator<const _Elem> const_column_iterator;
+		typedef Array2D_Range<iterator> row_range;
+		typedef Array2D_Range<const_iterator> const_row_range;
+		typedef Array2D_Range<column_iterator> column_range;
+		typedef Array2D_Range<const_column_iterator> const_column_range;
 	public:
 		Array2D(size_t h, size_t w)
-			:_data(new _ElementValue<_Elem, _Alloc>(h, w))
+			:_data(new _ElementValue(h, w))
 		{
 
 		}
@@ -626,55 +1148,102 @@ namespace arr
 
 		}
 
+		//뿽һֻдʱٸ
+		_Myt &operator=(const _Myt &rhs)
+		{
+			_data = rhs._data;
+			return *this;
+		}
+
 		template<class _Iter>
 		Array2D(size_t h, size_t w, _Iter first, _Iter last)
-			: _data(new _ElementValue<_Elem, _Alloc>(h, w, first, last))
+			: _data(new _ElementValue(h, w, first, last))
 		{
 
 		}
 
 		template<class... _Args>
 		Array2D(size_t h, size_t w, const _Args &... rest)
-			: _data(new _ElementValue<_Elem, _Alloc>(h, w, rest...))
+			: _data(new _ElementValue(h, w, rest...))
+		{
+
+		}
+
+		//пforEachRowBlockĶӦ߳״д룬first_touch_t
+		Array2D(size_t h, size_t w, first_touch_t)
+			: _data(new _ElementValue(h, w, first_touch, _Elem()))
 		{
 
 		}
 
+		template<class _Ty>
+		Array2D(size_t h, size_t w, first_touch_t, const _Ty &value)
+			: _data(new _ElementValue(h, w, first_touch, _Elem(value)))
+		{
+
+		}
+
+		//ԪΪf(row, col)й죬from_generator_t
+		template<class _Fn>
+		Array2D(size_t h, size_t w, from_generator_t, const _Fn &f)
+			: _data(new _ElementValue(h, w, from_generator, f))
+		{
+
+		}
+
+		//ʹpָⲿֻƣд֮ǰŸƵ˽ڴ
+		Array2D(size_t h, size_t w, external_buffer_t, const _Elem *p,
+			const std::function<void()> &release)
+			: _data(new _ElementValue(h, w, external_buffer, p, release))
+		{
+
+		}
+
+		//Ƿfirst_touchʽ
+		bool isFirstTouch() const { return _data->_firstTouch; }
+
+		//Ƿʹⲿֻ
+		bool isReadOnly() const { return _data.get()->isReadOnly(); }
+
+		//ݹϣڹ_ElementValue
+		size_t hash() const { return _data->hashValue(); }
+
+		//Ƿ
+		bool isShared() const { return _data.get()->isShared(); }
+
 		_InnerArray operator[](size_type index)
 		{
-			if (index >= h() || index < 0)
-				_DEBUG_ERROR("row out of range!");
+			if (index >= h())
+				ARRARY_DEBUG_ERROR("row out of range!");
 			_data->markUnshareable();//ֹͨlazy equvationԺеĿ
-			_Elem *_pdata = _data->ptr();//ǿƵ÷ǳԱmakeCopy
-			return const_cast<_InnerArray &>(static_cast<const Array2D &>(*this)[index]);
+			_data->ptr();//ǿƵ÷ǳԱmakeCopy
+			return static_cast<const Array2D &>(*this)[index];
 		}
 
 		const _InnerArray operator[](size_type index)const
 		{
-			if (index >= h() || index < 0)
-				_DEBUG_ERROR("row out of range!");
+			if (index >= h())
+				ARRARY_DEBUG_ERROR("row out of range!");
 			_Elem *_pdata = _data->ptr();//˴ᷢmakeCopy
 			return _InnerArray(_pdata + w()*index, w());
 		}
 
 		bool operator==(const _Myt &rhs)const throw()
 		{
-			if (this == &rhs)
+			if (this == &rhs || _data.get() == rhs._data.get())
 				return true;
 			if (_data->_w != rhs._data->_w
-				|| _data->_h != _data->_h)
+				|| _data->_h != rhs._data->_h)
 				return false;
-			bool _flag = true;
-			_Elem *plhs = _data->ptr(), *pend = plhs + _data->size(), *prhs = rhs._data->ptr();
-			for (; plhs != pend; plhs++, prhs++)
-			{
-				if (!(*prhs == *plhs))
-				{
-					_flag = false;
-					break;
-				}
-			}
-			return _flag;
+			//߶ѾлĹϣʱȱȽϹϣ
+			//ԪͲһstd::hashݾ
+			if constexpr (_HashKind<_Elem>::value != 2)
+				if (_data->hasCachedHash() && rhs._data->hasCachedHash()
+					&& _data->hashValue() != rhs._data->hashValue())
+					return false;
+			//std::equal͵ָmemcmp
+			const _Elem *plhs = _data->ptr(), *prhs = rhs._data->ptr();
+			return std::equal(plhs, plhs + _data->size(), prhs);
 		}
 
 		bool operator!=(const _Myt &rhs)const throw()
@@ -740,9 +1309,9 @@ namespace arr
 			return const_reverse_iterator(rend());
 		}
 
-		void swap(const _Myt &rhs) throw()
+		void swap(_Myt &rhs) throw()
 		{
-			_data.swap(rhs);
+			_data.swap(rhs._data);
 		}
 
 		//ʽṩat
@@ -751,13 +1320,89 @@ namespace arr
 			return (*this)[row][col];
 		}
 
-	protected:
-		virtual void _printPrivate(std::ostream &os,
-			char elementSeparator, char dimSeparator)const = 0;
+		//洢׵ַǳ汾begin()һֹ
+		_Elem *data()
+		{
+			_data->markUnshareable();
+			return _data->ptr();
+		}
+
+		const _Elem *data() const
+		{
+			return _data->ptr();
+		}
 
-		virtual ~Array2D() = 0 { }
+		size_t size() const { return _data->size(); }
 
-		_RCPtr<_ElementValue<_Elem, _Alloc> > _data;
+		//㷨дʱmakeCopyΪɹ
+		//صָֻڱһα֮ǰЧҪ
+		_Elem *_writableData()
+		{
+			return _data->_writablePtr();
+		}
+
+		//indexУ
+		row_range row(size_type index)
+		{
+			if (index >= h())
+				ARRARY_DEBUG_ERROR("row out of range!");
+			_Elem *p = data() + index * w();
+			return row_range(iterator(p), iterator(p + w()));
+		}
+
+		const_row_range row(size_type index) const
+		{
+			if (index >= h())
+				ARRARY_DEBUG_ERROR("row out of range!");
+			const _Elem *p = data() + index * w();
+			return const_row_range(const_iterator(p), const_iterator(p + w()));
+		}
+
+		//indexУΪw()
+		column_range col(size_type index)
+		{
+			if (index >= w())
+				ARRARY_DEBUG_ERROR("column out of range!");
+			_Elem *p = data() + index;
+			ptrdiff_t stride = static_cast<ptrdiff_t>(w());
+			return column_range(column_iterator(p, stride),
+				column_iterator(p, stride, static_cast<ptrdiff_t>(h())));
+		}
+
+		const_column_range col(size_type index) const
+		{
+			if (index >= w())
+				ARRARY_DEBUG_ERROR("column out of range!");
+			const _Elem *p = data() + index;
+			ptrdiff_t stride = static_cast<ptrdiff_t>(w());
+			return const_column_range(const_column_iterator(p, stride),
+				const_column_iterator(p, stride, static_cast<ptrdiff_t>(h())));
+		}
+
+		//û麯ֻһ_RCPtrprint̬ͷ
+		//ҪͬʽʱԼprintoperator<<ʵεľ͵
+		//ͨArray2Dõprintõĸʽ
+		void print(std::ostream &os = std::cout,
+			char elemSeparator = ' ', char dimSeparator = '\n')const
+		{
+			_printPrivate(os, elemSeparator, dimSeparator);
+		}
+
+	protected:
+		void _printPrivate(std::ostream &os,
+			char elemSeparator, char dimSeparator)const
+		{
+			const _Elem *p = data();
+			size_t sw = w();
+			for (size_t i = 0, sh = h(); i != sh; i++, p += sw)
+			{
+				for (size_t j = 0; j != sw; j++)
+					os << p[j] << elemSeparator;
+				os << dimSeparator;
+			}
+		}
+
+		_RCPtr<_ElementValue> _data;
 	private:
 		Array2D() { }
 	};
@@ -771,7 +1416,7 @@ namespace arr
 		{
 			typedef _Array1D _Myt;
 			typedef Array2D<bool, _Alloc> _MyVec;
-			friend class _MyVec;
+			friend _MyVec;
 
 			typedef random_access_iterator_tag iterator_category;
 			typedef bool value_type;
@@ -789,8 +1434,8 @@ namespace arr
 
 			const_reference operator[](size_type index) const
 			{
-				if (index >= _sz || index < 0)
-					_DEBUG_ERROR("row out of range!");
+				if (index >= _sz)
+					ARRARY_DEBUG_ERROR("row out of range!");
 				return this->_ptr[index];
 			}
 		private:
@@ -809,12 +1454,11 @@ namespace arr
 			}
 		};
 
-		template<typename _Alloc>
 		struct _ElementValue :
-			public _RCObject<_ElementValue<_Alloc>>
+			public _RCObject<_ElementValue>
 		{
-			typedef _ElementValue<_Alloc> _Myt;
-			typedef _RCObject<_ElementValue<_Alloc> > _Base;
+			typedef _ElementValue _Myt;
+			typedef _RCObject<_ElementValue> _Base;
 			typedef _Alloc allocator_type;
 			typedef bool * pointer;
 
@@ -857,14 +1501,12 @@ namespace arr
 				}
 			}
 
-			~_ElementValue()OVERRIDE
+			~_ElementValue()
 			{
 				//never throw
 				try
 				{
-					allocator_type _alloc = _memCenter.first;
-					bool *_pdata = _memCenter.second;
-					_alloc.deallocate(_pdata, _h*_w);
+					_memCenter.first.deallocate(_memCenter.second, _h*_w);
 				}
 				catch (...) {}
 			}
@@ -892,19 +1534,10 @@ namespace arr
 			void _init(size_t h, size_t w)
 			{
 				if (h == 0 || w == 0)
-					_DEBUG_ERROR("dimension can not be zero!");
-				try
-				{
-					allocator_type _alloc;
-					_memCenter.first = _alloc;
-					bool *_pdata = _alloc.allocate(_h * _w);
-					_memCenter.second = _pdata;
-				}
-				catch (...)
-				{
-					_memCenter.first.deallocate(_memCenter.second, _h * _w);
-					throw;
-				}
+					ARRARY_DEBUG_ERROR("dimension can not be zero!");
+				allocator_type _alloc;
+				_memCenter.first = _alloc;
+				_memCenter.second = _alloc.allocate(_h * _w);
 			}
 		};
 
@@ -913,10 +1546,10 @@ namespace arr
 		typedef size_t size_type;
 		typedef ptrdiff_t difference_type;
 		typedef _Alloc allocator_type;
-		typedef Array2D<_Alloc> _Myt;
+		typedef Array2D<bool, _Alloc> _Myt;
 	public:
 		Array2D(size_t h, size_t w)
-			:_data(new _ElementValue<_Alloc>(h, w))
+			:_data(new _ElementValue(h, w))
 		{
 
 		}
@@ -927,48 +1560,46 @@ namespace arr
 
 		}
 
+		//뿽һֻдʱٸ
+		_Myt &operator=(const _Myt &rhs)
+		{
+			_data = rhs._data;
+			return *this;
+		}
+
 		template<class _Iter>
 		Array2D(size_t h, size_t w, _Iter first, _Iter last)
-			: _data(new _ElementValue<_Alloc>(h, w, first, last))
+			: _data(new _ElementValue(h, w, first, last))
 		{
 
 		}
 
 		_InnerArray operator[](size_type index)
 		{
-			if (index >= h() || index < 0)
-				_DEBUG_ERROR("row out of range!");
+			if (index >= h())
+				ARRARY_DEBUG_ERROR("row out of range!");
 			_data->markUnshareable();//ֹͨlazy equvationԺеĿ
-			bool *pdata = _data->ptr();//ǿƵ÷ǳԱmakeCopy
-			return const_cast<_InnerArray &>(static_cast<const Array2D &>(*this)[index]);
+			_data->ptr();//ǿƵ÷ǳԱmakeCopy
+			return static_cast<const Array2D &>(*this)[index];
 		}
 
 		const _InnerArray operator[](size_type index)const
 		{
-			if (index >= h() || index < 0)
-				_DEBUG_ERROR("row out of range!");
+			if (index >= h())
+				ARRARY_DEBUG_ERROR("row out of range!");
 			bool *_pdata = _data->ptr();//˴ᷢmakeCopy
 			return _InnerArray(_pdata + w()*index, w());
 		}
 
 		bool operator==(const _Myt &rhs)const throw()
 		{
-			if (this == &rhs)
+			if (this == &rhs || _data.get() == rhs._data.get())
 				return true;
 			if (_data->_w != rhs._data->_w
-				|| _data->_h != _data->_h)
+				|| _data->_h != rhs._data->_h)
 				return false;
-			bool _flag = true;
-			_Elem *plhs = _data->ptr(), *pend = plhs + _data->size(), *prhs = rhs._data->ptr();
-			for (; plhs != pend; plhs++, prhs++)
-			{
-				if (!(*prhs == *plhs))
-				{
-					_flag = false;
-					break;
-				}
-			}
-			return _flag;
+			const bool *plhs = _data->ptr(), *prhs = rhs._data->ptr();
+			return std::equal(plhs, plhs + _data->size(), prhs);
 		}
 
 		bool operator!=(const _Myt &rhs)const throw()
@@ -980,9 +1611,9 @@ namespace arr
 
 		size_t w() const { return _data->_w; }
 
-		void swap(const _Myt &rhs) throw()
+		void swap(_Myt &rhs) throw()
 		{
-			_data.swap(rhs);
+			_data.swap(rhs._data);
 		}
 
 		//ʽṩat
@@ -991,17 +1622,55 @@ namespace arr
 			return (*this)[row][col];
 		}
 
-	protected:
-		virtual void _printPrivate(std::ostream &os,
-			char elementSeparator, char dimSeparator)const = 0;
+		void print(std::ostream &os = std::cout,
+			char elemSeparator = ' ', char dimSeparator = '\n')const
+		{
+			_printPrivate(os, elemSeparator, dimSeparator);
+		}
 
-		virtual ~Array2D() = 0 { }
+	protected:
+		void _printPrivate(std::ostream &os,
+			char elemSeparator, char dimSeparator)const
+		{
+			const bool *p = _data->ptr();
+			size_t sw = w();
+			for (size_t i = 0, sh = h(); i != sh; i++, p += sw)
+			{
+				for (size_t j = 0; j != sw; j++)
+					os << p[j] << elemSeparator;
+				os << dimSeparator;
+			}
+		}
 
-		_RCPtr<_ElementValue<_Alloc> > _data;
+		_RCPtr<_ElementValue> _data;
 	private:
 		Array2D() { }
 	};
 
+	//n x nķԭתã_TransposeTileֿ齻(i, j)(j, i)
+	//j < iÿһֻɵiڵп鴦п黥ص
+	const size_t _TransposeTile = 32;
+
+	template<class _Elem>
+	void _transposeSquare(_Elem *p, size_t n)
+	{
+		forEachRowBlock(n, n / 2, [=](size_t first, size_t last, size_t)
+		{
+			using std::swap;
+			for (size_t bi = first; bi < last; bi += _TransposeTile)
+			{
+				size_t ei = std::min(bi + _TransposeTile, last);
+				for (size_t bj = 0; bj < ei; bj += _TransposeTile)
+					for (size_t i = bi; i != ei; i++)
+					{
+						size_t ej = std::min(bj + _TransposeTile, i);
+						for (size_t j = bj; j < ej; j++)
+							swap(p[i * n + j], p[j * n + i]);
+					}
+			}
+		});
+	}
+
 	//
 	template<typename _Elem, typename _Alloc = allocator<_Elem>>
 	class SquareMartrix :public Array2D<_Elem, _Alloc>
@@ -1011,7 +1680,7 @@ namespace arr
 		typedef Array2D<_Elem, _Alloc> _Base;
 
 		explicit SquareMartrix(size_t length = 3)
-			:Array2D(length, length)
+			:_Base(length, length)
 		{
 
 		}
@@ -1019,20 +1688,20 @@ namespace arr
 		//TODO: Ҹ취_IterͲ
 		template<class _Iter>
 		SquareMartrix(size_t length, _Iter first, _Iter last)
-			: Array2D(length, length, first, last)
+			: _Base(length, length, first, last)
 		{
 
 		}
 
 		SquareMartrix(const _Myt &right)
-			:Array2D(right)
+			:_Base(right)
 		{
 
 		}
 
 		template<class... _Args>
 		explicit SquareMartrix(size_t length, const _Args &... rest)
-			: Array2D(length, length, rest...)
+			: _Base(length, length, rest...)
 		{
 
 		}
@@ -1040,64 +1709,71 @@ namespace arr
 		_Myt &operator=(const _Myt &right)
 		{
 			if (right.w() != right.h())
-				_DEBUG_ERROR("the object assigned isn't the array");
-			if (w() != right.w())
-				_DEBUG_ERROR("the object dimension isn't same as the the object assigned");
+				ARRARY_DEBUG_ERROR("the object assigned isn't the array");
+			if (this->w() != right.w())
+				ARRARY_DEBUG_ERROR("the object dimension isn't same as the the object assigned");
 
 			this->_Base::operator=(right);
 			return *this;
 		}
 
-		bool operator==(const SquareMartrix &rhs)
+		bool operator==(const SquareMartrix &rhs) const
 		{
 			return (*this)._Base::operator==(rhs);
 		}
 
-		bool operator!=(const SquareMartrix &rhs)
+		bool operator!=(const SquareMartrix &rhs) const
 		{
 			return !((*this) == rhs);
 		}
 
-		~SquareMartrix() OVERRIDE
-		{
-
-		}
-
-		void print(std::ostream &os = std::cout,
-			char elemSeparator = ' ', char dimSeparator = '\n')const
-		{
-			_printPrivate(os, elemSeparator, dimSeparator);
-		}
-
 		template<class _Iter>
 		void input(_Iter first, _Iter last)
 		{
-			_data->_input(first, last);
+			this->_data->_input(first, last);
 		}
 
+		//ԭתã齻(i, j)(j, i)ߵһҲڻ
 		void change()
 		{
-			using std::swap;
-			size_t sz = w();
-			for (size_t i = 0; i < sz; i++)
-				for (size_t j = 0; j < i; j++)
-					swap((*this)[i][j], (*this)[j][i]);
+			_transposeSquare(this->_writableData(), this->w());
 		}
-	protected:
-		void _printPrivate(std::ostream &os,
-			char elemSeparator, char dimSeparator)const OVERRIDE
+	};
+
+	//h x w飬ÿԪֻдһ
+	//԰ֽڸʱȷ䲻ʼĻkernel(pd, first, last)д[first, last)У
+	//пforEachRowBlock߳״д룻Ԫذfrom_generatorgen(row, col)
+	template<class _Elem, class _Alloc = allocator<_Elem>, class _Kernel, class _Gen>
+	Array2D<_Elem, _Alloc> _writeOnce(size_t h, size_t w, _Kernel kernel, const _Gen &gen)
+	{
+		if constexpr (is_trivially_copyable<_Elem>::value)
 		{
-			for (int i = 0; i != h(); i++)
+			Array2D<_Elem, _Alloc> dst(h, w);
+			_Elem *pd = dst._writableData();
+			forEachRowBlock(h, w, [=](size_t first, size_t last, size_t)
 			{
-				for (int j = 0; j != w(); j++)
-					os << (*this)[i][j] << elemSeparator;
-				os << dimSeparator;
-			}
+				kernel(pd, first, last);
+			});
+			return dst;
 		}
-	};
+		else
+			return Array2D<_Elem, _Alloc>(h, w, from_generator, gen);
+	}
+
+	template<class _Elem, class _Alloc>
+	true_type _isArray2D(const Array2D<_Elem, _Alloc> *);
+
+	false_type _isArray2D(...);
+
+	//_ArrayArray2D
+	template<class _Array>
+	struct _IsArray2D :decltype(_isArray2D(static_cast<const _Array *>(nullptr)))
+	{ };
 
-	template<class _Elem, typename _Alloc = allocator<_Elem>>
-	inline std::ostream &__CLR_OR_THIS_CALL operator<<(std::ostream &os, const SquareMartrix<_Elem, _Alloc> &out)
+	//ģʵεľ(CRTPʽľ̬)صprintᱻ
+	template<class _Array>
+	inline typename enable_if<_IsArray2D<_Array>::value, std::ostream &>::type
+		operator<<(std::ostream &os, const _Array &out)
 	{
 		out.print(os);
 		return os;
@@ -0,0 +1,207 @@
+/* SquareBatch
+ * NͬСSquareMartrixʹ
+ * 洢(interleaved)k(i,j)Ԫλ _data[(i*n + j)*N + k]
+ * ڲѭؾ򣬱԰NĴ
+ * ֻһη䣬ûü
+*/
+
+#ifndef ARRARY_BATCH
+#define ARRARY_BATCH
+
+#include "array.h"
+#include <cmath>
+#include <vector>
+
+namespace arr
+{
+	template<typename _Elem, typename _Alloc = allocator<_Elem>>
+	class SquareBatch
+	{
+	public:
+		typedef SquareBatch<_Elem, _Alloc> _Myt;
+		typedef SquareMartrix<_Elem, _Alloc> matrix_type;
+		typedef _Elem value_type;
+		typedef size_t size_type;
+		typedef _Alloc allocator_type;
+
+		SquareBatch(size_t order, size_t count)
+			:_n(order), _count(count), _data(order * order * count)
+		{
+			if (order == 0 || count == 0)
+				ARRARY_DEBUG_ERROR("dimension can not be zero!");
+		}
+
+		//[first, last)һSquareMartrixһ
+		template<class _Iter,
+			class = typename enable_if<!std::is_integral<_Iter>::value>::type>
+		SquareBatch(_Iter first, _Iter last)
+			:_n(0), _count(std::distance(first, last))
+		{
+			if (_count == 0)
+				ARRARY_DEBUG_ERROR("dimension can not be zero!");
+			_n = first->w();
+			_data.resize(_n * _n * _count);
+			for (size_t k = 0; first != last; ++first, ++k)
+				set(k, *first);
+		}
+
+		size_t order() const { return _n; }
+
+		size_t count() const { return _count; }
+
+		//k(row, col)Ԫ
+		_Elem &at(size_t k, size_t row, size_t col)
+		{
+			return const_cast<_Elem &>(static_cast<const _Myt &>(*this).at(k, row, col));
+		}
+
+		const _Elem &at(size_t k, size_t row, size_t col) const
+		{
+			if (k >= _count || row >= _n || col >= _n)
+				ARRARY_DEBUG_ERROR("index out of range!");
+			return _data[(row * _n + col) * _count + k];
+		}
+
+		//(row, col)λоԪأcount()
+		_Elem *lane(size_t row, size_t col)
+		{
+			return &_data[(row * _n + col) * _count];
+		}
+
+		const _Elem *lane(size_t row, size_t col) const
+		{
+			return &_data[(row * _n + col) * _count];
+		}
+
+		void set(size_t k, const matrix_type &m)
+		{
+			if (m.w() != _n)
+				ARRARY_DEBUG_ERROR("the matrix dimension isn't same as the batch");
+			if (k >= _count)
+				ARRARY_DEBUG_ERROR("index out of range!");
+			typename matrix_type::const_iterator it = m.begin();
+			_Elem *p = &_data[k];
+			for (size_t i = 0, len = _n * _n; i != len; ++i, ++it, p += _count)
+				*p = *it;
+		}
+
+		matrix_type get(size_t k) const
+		{
+			if (k >= _count)
+				ARRARY_DEBUG_ERROR("index out of range!");
+			std::vector<_Elem, _Alloc> tmp(_n * _n);
+			const _Elem *p = &_data[k];
+			for (size_t i = 0, len = _n * _n; i != len; ++i, p += _count)
+				tmp[i] = *p;
+			return matrix_type(_n, tmp.begin(), tmp.end());
+		}
+
+		//ˣ(*this)[k] * rhs[k]
+		_Myt multiply(const _Myt &rhs) const
+		{
+			if (_n != rhs._n || _count != rhs._count)
+				ARRARY_DEBUG_ERROR("the batch dimension isn't same as the batch multiplied");
+			_Myt result(_n, _count);
+			for (size_t i = 0; i != _n; i++)
+				for (size_t j = 0; j != _n; j++)
+				{
+					_Elem *ARRARY_RESTRICT po = result.lane(i, j);
+					for (size_t l = 0; l != _n; l++)
+					{
+						const _Elem *ARRARY_RESTRICT pa = lane(i, l), *ARRARY_RESTRICT pb = rhs.lane(l, j);
+						for (size_t k = 0; k != _count; k++)
+							po[k] += pa[k] * pb[k];
+					}
+				}
+			return result;
+		}
+
+		//SquareMartrix::changeһ£ԭתÿһ
+		void change()
+		{
+			for (size_t i = 0; i < _n; i++)
+				for (size_t j = 0; j < i; j++)
+					std::swap_ranges(lane(i, j), lane(i, j) + _count, lane(j, i));
+		}
+
+		//Gauss-Jordan棬ѡԪʱԪʱؾ
+		//ĸsingularΪʱ¼ÿǷ죬Ľ
+		size_t inverse(_Myt &out, std::vector<char> *singular = 0) const
+		{
+			using std::abs;
+			using std::swap;
+
+			_Myt a(*this);
+			out = _Myt(_n, _count);
+			for (size_t i = 0; i != _n; i++)
+				std::fill(out.lane(i, i), out.lane(i, i) + _count, _Elem(1));
+
+			std::vector<char> flags(_count, 0);
+			std::vector<_Elem, _Alloc> factor(_count);
+			for (size_t c = 0; c != _n; c++)
+			{
+				for (size_t k = 0; k != _count; k++)
+				{
+					size_t p = c;
+					for (size_t r = c + 1; r != _n; r++)
+						if (abs(a.at(k, r, c)) > abs(a.at(k, p, c)))
+							p = r;
+					if (a.at(k, p, c) == _Elem(0))
+					{
+						flags[k] = 1;
+						a.at(k, c, c) = _Elem(1);
+						continue;
+					}
+					if (p != c)
+						for (size_t j = 0; j != _n; j++)
+						{
+							swap(a.at(k, p, j), a.at(k, c, j));
+							swap(out.at(k, p, j), out.at(k, c, j));
+						}
+				}
+
+				const _Elem *pd = a.lane(c, c);
+				for (size_t k = 0; k != _count; k++)
+					factor[k] = _Elem(1) / pd[k];
+				for (size_t j = 0; j != _n; j++)
+				{
+					_Elem *pa = a.lane(c, j), *po = out.lane(c, j);
+					for (size_t k = 0; k != _count; k++)
+					{
+						pa[k] *= factor[k];
+						po[k] *= factor[k];
+					}
+				}
+
+				for (size_t r = 0; r != _n; r++)
+				{
+					if (r == c)
+						continue;
+					const _Elem *pf = a.lane(r, c);
+					for (size_t k = 0; k != _count; k++)
+						factor[k] = pf[k];
+					for (size_t j = 0; j != _n; j++)
+					{
+						_Elem *pa = a.lane(r, j), *po = out.lane(r, j);
+						const _Elem *pca = a.lane(c, j), *pco = out.lane(c, j);
+						for (size_t k = 0; k != _count; k++)
+						{
+							pa[k] -= factor[k] * pca[k];
+							po[k] -= factor[k] * pco[k];
+						}
+					}
+				}
+			}
+
+			size_t cnt = std::count(flags.begin(), flags.end(), 1);
+			if (singular)
+				singular->swap(flags);
+			return cnt;
+		}
+	private:
+		size_t _n, _count;
+		std::vector<_Elem, _Alloc> _data;
+	};
+}
+
+#endif // !ARRARY_BATCH
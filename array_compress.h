@@ -0,0 +1,336 @@
+/* CompressedArray2D
+ * ݵѹ洢̶Ԫظֿѹⲿ
+ * ڲ + zigzag + λ
+ * 㣺ǰһֵλģʽȥβֽںֽڱ棬ÿֵ7λͷ
+ * ԭ
+ * ȡʱѹһСLRUͳѹʺͽѹʱ
+ * ͳһ߳̿ͬʱͬһ
+*/
+
+#ifndef ARRARY_COMPRESS
+#define ARRARY_COMPRESS
+
+#include "array.h"
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <vector>
+
+namespace arr
+{
+	//λдͶλǰ
+	class _BitWriter
+	{
+	public:
+		explicit _BitWriter(std::vector<unsigned char> &out)
+			:_out(out), _acc(0), _bits(0)
+		{ }
+
+		void put(unsigned long long v, unsigned n)
+		{
+			while (n)
+			{
+				unsigned take = std::min(n, 8 - _bits);
+				_acc |= static_cast<unsigned>(v & ((1u << take) - 1)) << _bits;
+				v >>= take;
+				n -= take;
+				if ((_bits += take) == 8)
+				{
+					_out.push_back(static_cast<unsigned char>(_acc));
+					_acc = 0;
+					_bits = 0;
+				}
+			}
+		}
+
+		void flush()
+		{
+			if (_bits)
+				_out.push_back(static_cast<unsigned char>(_acc));
+			_acc = 0;
+			_bits = 0;
+		}
+	private:
+		std::vector<unsigned char> &_out;
+		unsigned _acc, _bits;
+	};
+
+	class _BitReader
+	{
+	public:
+		explicit _BitReader(const unsigned char *p)
+			:_p(p), _pos(0)
+		{ }
+
+		unsigned long long get(unsigned n)
+		{
+			unsigned long long v = 0;
+			for (unsigned i = 0; i != n;)
+			{
+				unsigned off = static_cast<unsigned>(_pos & 7);
+				unsigned take = std::min(n - i, 8 - off);
+				v |= static_cast<unsigned long long>((_p[_pos >> 3] >> off) & ((1u << take) - 1)) << i;
+				i += take;
+				_pos += take;
+			}
+			return v;
+		}
+	private:
+		const unsigned char *_p;
+		size_t _pos;
+	};
+
+	template<typename _Elem>
+	class CompressedArray2D
+	{
+		//01㣬2ԭ
+		typedef integral_constant<int,
+			(is_integral<_Elem>::value && sizeof(_Elem) <= 8) ? 0
+			: (is_floating_point<_Elem>::value && sizeof(_Elem) <= 8) ? 1 : 2> _Kind;
+	public:
+		typedef CompressedArray2D<_Elem> _Myt;
+		typedef _Elem value_type;
+
+		template<class _Alloc>
+		explicit CompressedArray2D(const Array2D<_Elem, _Alloc> &src,
+			size_t blockSize = 4096, size_t cacheBlocks = 4)
+			:_h(src.h()), _w(src.w()), _blockSize(blockSize), _cacheBlocks(cacheBlocks),
+			_decompressCount(0), _decompressNanos(0)
+		{
+			static_assert(is_trivially_copyable<_Elem>::value, "CompressedArray2D only supports trivially copyable elements");
+			if (blockSize == 0 || cacheBlocks == 0)
+				ARRARY_DEBUG_ERROR("block size can not be zero!");
+			const _Elem *p = &*src.begin();
+			size_t n = _h * _w;
+			for (size_t first = 0; first < n; first += _blockSize)
+			{
+				_offsets.push_back(_bytes.size());
+				_encode(p + first, std::min(_blockSize, n - first), _Kind());
+			}
+			_offsets.push_back(_bytes.size());
+			std::vector<unsigned char>(_bytes).swap(_bytes);
+		}
+
+		//ֻѹݣͳƴ㿪ʼ
+		CompressedArray2D(const _Myt &rhs)
+			:_h(rhs._h), _w(rhs._w), _blockSize(rhs._blockSize), _cacheBlocks(rhs._cacheBlocks),
+			_bytes(rhs._bytes), _offsets(rhs._offsets), _decompressCount(0), _decompressNanos(0)
+		{ }
+
+		_Myt &operator=(const _Myt &rhs)
+		{
+			if (this != &rhs)
+			{
+				std::lock_guard<std::mutex> lock(_cacheMutex);
+				_h = rhs._h;
+				_w = rhs._w;
+				_blockSize = rhs._blockSize;
+				_cacheBlocks = rhs._cacheBlocks;
+				_bytes = rhs._bytes;
+				_offsets = rhs._offsets;
+				_cache.clear();
+				_decompressCount = 0;
+				_decompressNanos = 0;
+			}
+			return *this;
+		}
+
+		size_t h() const { return _h; }
+
+		size_t w() const { return _w; }
+
+		_Elem at(size_t row, size_t col) const
+		{
+			if (row >= _h || col >= _w)
+				ARRARY_DEBUG_ERROR("index out of range!");
+			size_t idx = row * _w + col;
+			//صǸ֮߳̿ܰһ黻ȥ
+			std::lock_guard<std::mutex> lock(_cacheMutex);
+			return _block(idx / _blockSize)[idx % _blockSize];
+		}
+
+		//ѹdstdstάȱһ£
+		template<class _Alloc>
+		void decompress(Array2D<_Elem, _Alloc> &dst) const
+		{
+			if (dst.h() != _h || dst.w() != _w)
+				ARRARY_DEBUG_ERROR("the object dimension isn't same as the the object assigned");
+			_Elem *p = dst._writableData();
+			for (size_t b = 0; b + 1 < _offsets.size(); b++)
+			{
+				size_t first = b * _blockSize;
+				_decode(b, p + first, std::min(_blockSize, _h * _w - first), _Kind());
+			}
+		}
+
+		size_t rawBytes() const
+		{
+			return _h * _w * sizeof(_Elem);
+		}
+
+		size_t compressedBytes() const
+		{
+			return _bytes.size() + _offsets.size() * sizeof(size_t);
+		}
+
+		//ԭʼС / ѹС
+		double compressionRatio() const
+		{
+			return static_cast<double>(rawBytes()) / compressedBytes();
+		}
+
+		//δʱѹĿۼƺʱ()
+		size_t decompressCount() const
+		{
+			std::lock_guard<std::mutex> lock(_cacheMutex);
+			return _decompressCount;
+		}
+
+		double decompressSeconds() const
+		{
+			std::lock_guard<std::mutex> lock(_cacheMutex);
+			return _decompressNanos * 1e-9;
+		}
+	private:
+		typedef std::vector<_Elem> _Block;
+
+		//ʱ_cacheMutex
+		const _Block &_block(size_t b) const
+		{
+			for (typename std::list<pair<size_t, _Block> >::iterator it = _cache.begin();
+				it != _cache.end(); ++it)
+				if (it->first == b)
+				{
+					_cache.splice(_cache.begin(), _cache, it);
+					return it->second;
+				}
+
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			if (_cache.size() < _cacheBlocks)
+				_cache.push_front(pair<size_t, _Block>(b, _Block(_blockSize)));
+			else
+				_cache.splice(_cache.begin(), _cache, --_cache.end());
+			_cache.front().first = b;
+			size_t first = b * _blockSize;
+			_decode(b, &_cache.front().second[0], std::min(_blockSize, _h * _w - first), _Kind());
+			_decompressCount++;
+			_decompressNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - start).count();
+			return _cache.front().second;
+		}
+
+		static unsigned long long _zigzag(unsigned long long d)
+		{
+			return (d << 1) ^ (0 - (d >> 63));
+		}
+
+		static unsigned long long _unzigzag(unsigned long long z)
+		{
+			return (z >> 1) ^ (0 - (z & 1));
+		}
+
+		static unsigned _bitWidth(unsigned long long v)
+		{
+			unsigned n = 0;
+			for (; v; v >>= 1)
+				n++;
+			return n;
+		}
+
+		//[Ԫ8ֽ][λ1ֽ][n-1zigzag]
+		void _encode(const _Elem *p, size_t n, integral_constant<int, 0>)
+		{
+			unsigned long long prev = static_cast<unsigned long long>(p[0]), maxz = 0;
+			std::vector<unsigned long long> z(n);
+			for (size_t i = 1; i != n; i++)
+			{
+				unsigned long long cur = static_cast<unsigned long long>(p[i]);
+				z[i] = _zigzag(cur - prev);
+				maxz |= z[i];
+				prev = cur;
+			}
+			unsigned width = _bitWidth(maxz);
+			_BitWriter out(_bytes);
+			out.put(static_cast<unsigned long long>(p[0]), 64);
+			out.put(width, 8);
+			for (size_t i = 1; i != n; i++)
+				out.put(z[i], width);
+			out.flush();
+		}
+
+		void _decode(size_t b, _Elem *dst, size_t n, integral_constant<int, 0>) const
+		{
+			_BitReader in(&_bytes[_offsets[b]]);
+			unsigned long long prev = in.get(64);
+			unsigned width = static_cast<unsigned>(in.get(8));
+			dst[0] = static_cast<_Elem>(prev);
+			for (size_t i = 1; i != n; i++)
+			{
+				prev += _unzigzag(in.get(width));
+				dst[i] = static_cast<_Elem>(prev);
+			}
+		}
+
+		static unsigned long long _bitsOf(const _Elem &x)
+		{
+			unsigned long long bits = 0;
+			std::memcpy(&bits, &x, sizeof(_Elem));
+			return bits;
+		}
+
+		//ÿֵ3λĩβֽ4λЧֽȻЧֽ
+		void _encode(const _Elem *p, size_t n, integral_constant<int, 1>)
+		{
+			_BitWriter out(_bytes);
+			unsigned long long prev = 0;
+			for (size_t i = 0; i != n; i++)
+			{
+				unsigned long long bits = _bitsOf(p[i]), x = bits ^ prev;
+				unsigned tz = 0;
+				if (x)
+					for (; (x & 0xff) == 0; x >>= 8)
+						tz++;
+				unsigned len = (_bitWidth(x) + 7) / 8;
+				out.put(tz, 3);
+				out.put(len, 4);
+				out.put(x, len * 8);
+				prev = bits;
+			}
+			out.flush();
+		}
+
+		void _decode(size_t b, _Elem *dst, size_t n, integral_constant<int, 1>) const
+		{
+			_BitReader in(&_bytes[_offsets[b]]);
+			unsigned long long prev = 0;
+			for (size_t i = 0; i != n; i++)
+			{
+				unsigned tz = static_cast<unsigned>(in.get(3));
+				unsigned len = static_cast<unsigned>(in.get(4));
+				prev ^= in.get(len * 8) << (tz * 8);
+				std::memcpy(dst + i, &prev, sizeof(_Elem));
+			}
+		}
+
+		void _encode(const _Elem *p, size_t n, integral_constant<int, 2>)
+		{
+			const unsigned char *bytes = reinterpret_cast<const unsigned char *>(p);
+			_bytes.insert(_bytes.end(), bytes, bytes + n * sizeof(_Elem));
+		}
+
+		void _decode(size_t b, _Elem *dst, size_t n, integral_constant<int, 2>) const
+		{
+			std::memcpy(dst, &_bytes[_offsets[b]], n * sizeof(_Elem));
+		}
+
+		size_t _h, _w, _blockSize, _cacheBlocks;
+		std::vector<unsigned char> _bytes;
+		std::vector<size_t> _offsets;
+		mutable std::list<pair<size_t, _Block> > _cache;
+		mutable size_t _decompressCount;
+		mutable long long _decompressNanos;
+		mutable std::mutex _cacheMutex;
+	};
+}
+
+#endif // !ARRARY_COMPRESS
@@ -0,0 +1,412 @@
+/* Array2DԪת
+ * Half/BFloat1616λĴ洢ͣfloat֮䰴IEEEͽȡż
+ * saturateCastתʱȽضϵĿ͵ķΧپͽȡż룬NaN0
+ * convert<_To>(src)ԪתforEachRowBlockп鲢У
+ *   ڲָûз֧ѭֻдһ(_writeOnce)
+ * QuantizedArray2D x = (q - zeroPoint) * scaleм
+ *   ֵdequantizeĽֻͬдһ
+*/
+
+#ifndef ARRARY_CONVERT
+#define ARRARY_CONVERT
+
+#include "array.h"
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace arr
+{
+	inline unsigned _floatBits(float f)
+	{
+		unsigned u;
+		std::memcpy(&u, &f, sizeof(u));
+		return u;
+	}
+
+	inline float _bitsFloat(unsigned u)
+	{
+		float f;
+		std::memcpy(&f, &u, sizeof(f));
+		return f;
+	}
+
+	//float -> binary16ͽȡżinfNaNNaN
+	inline unsigned short _floatToHalf(float f)
+	{
+		unsigned u = _floatBits(f), sign = u & 0x80000000u, o;
+		u ^= sign;
+		if (u >= (143u << 23))
+			o = u > 0x7f800000u ? 0x7e00u : 0x7c00u;
+		else if (u < (113u << 23))
+			//ǹһħFPUλ
+			o = _floatBits(_bitsFloat(u) + _bitsFloat(126u << 23)) - (126u << 23);
+		else
+		{
+			unsigned odd = (u >> 13) & 1;
+			u += (unsigned(15 - 127) << 23) + 0xfff + odd;
+			o = u >> 13;
+		}
+		return static_cast<unsigned short>(o | (sign >> 16));
+	}
+
+	inline float _halfToFloat(unsigned short h)
+	{
+		unsigned o = (h & 0x7fffu) << 13, exp = o & (0x7c00u << 13);
+		o += unsigned(127 - 15) << 23;
+		if (exp == (0x7c00u << 13))
+			o += unsigned(128 - 16) << 23;
+		else if (exp == 0)
+			o = _floatBits(_bitsFloat(o + (1u << 23)) - _bitsFloat(113u << 23));
+		return _bitsFloat(o | ((h & 0x8000u) << 16));
+	}
+
+	//float -> bfloat16ͽȡżNaNNaN
+	inline unsigned short _floatToBFloat16(float f)
+	{
+		unsigned u = _floatBits(f);
+		if ((u & 0x7fffffffu) > 0x7f800000u)
+			return static_cast<unsigned short>((u >> 16) | 0x40);
+		return static_cast<unsigned short>((u + 0x7fff + ((u >> 16) & 1)) >> 16);
+	}
+
+	inline float _bfloat16ToFloat(unsigned short b)
+	{
+		return _bitsFloat(unsigned(b) << 16);
+	}
+
+	class Half
+	{
+	public:
+		Half() :_bits(0) { }
+
+		explicit Half(float f) :_bits(_floatToHalf(f)) { }
+
+		operator float() const { return _halfToFloat(_bits); }
+
+		unsigned short bits() const { return _bits; }
+
+		static Half fromBits(unsigned short bits)
+		{
+			Half h;
+			h._bits = bits;
+			return h;
+		}
+
+		bool operator==(const Half &rhs) const { return _bits == rhs._bits; }
+
+		bool operator!=(const Half &rhs) const { return _bits != rhs._bits; }
+	private:
+		unsigned short _bits;
+	};
+
+	class BFloat16
+	{
+	public:
+		BFloat16() :_bits(0) { }
+
+		explicit BFloat16(float f) :_bits(_floatToBFloat16(f)) { }
+
+		operator float() const { return _bfloat16ToFloat(_bits); }
+
+		unsigned short bits() const { return _bits; }
+
+		static BFloat16 fromBits(unsigned short bits)
+		{
+			BFloat16 b;
+			b._bits = bits;
+			return b;
+		}
+
+		bool operator==(const BFloat16 &rhs) const { return _bits == rhs._bits; }
+
+		bool operator!=(const BFloat16 &rhs) const { return _bits != rhs._bits; }
+	private:
+		unsigned short _bits;
+	};
+
+	//0 -> 1 -> 2תɸ
+	template<class _To, class _From>
+	struct _CastKind :integral_constant<int,
+		!is_integral<_To>::value ? 2 : is_integral<_From>::value ? 0 : 1>
+	{ };
+
+	template<class _To, class _From>
+	inline _To _saturateCast(_From x, integral_constant<int, 0>)
+	{
+		typedef std::numeric_limits<_To> _Lim;
+		if (x < _From(0))
+		{
+			if (!_Lim::is_signed)
+				return _To(0);
+			if (static_cast<long long>(x) < static_cast<long long>(_Lim::min()))
+				return _Lim::min();
+		}
+		else if (static_cast<unsigned long long>(x) > static_cast<unsigned long long>(_Lim::max()))
+			return _Lim::max();
+		return static_cast<_To>(x);
+	}
+
+	template<class _To, class _From>
+	inline _To _saturateCast(_From x, integral_constant<int, 1>)
+	{
+		typedef typename std::conditional<is_floating_point<_From>::value, _From, float>::type _Real;
+		typedef std::numeric_limits<_To> _Lim;
+		_Real v = static_cast<_Real>(x);
+		//Ƚضϵ˶ķΧڣnearbyintȷ룬ȫѡûз֧
+		//_Toֵ_Realﲻһܾȷʾ(floatINT_MAXλ2^31)
+		//ʱضϵǸλֵ뵥ֵ
+		_Real lo = static_cast<_Real>(_Lim::min()), top = static_cast<_Real>(_Lim::max());
+		bool exact = std::numeric_limits<_Real>::digits >= _Lim::digits;
+		_Real hi = exact ? top : std::nextafter(top, _Real(0));
+		bool over = !exact && v >= top;
+		v = v != v ? _Real(0) : v;
+		v = v > lo ? v : lo;
+		v = v < hi ? v : hi;
+		_To r = static_cast<_To>(std::nearbyint(v));
+		return over ? _Lim::max() : r;
+	}
+
+	//floatĸ -> float뵽ȷʱ0ضϲλ1
+	//֮Half/BFloat16ֻһ룬ֱӾͽȡżһ
+	template<class _Real>
+	inline float _narrowToOdd(_Real x)
+	{
+		float f = static_cast<float>(x);
+		_Real back = static_cast<_Real>(f);
+		unsigned u = _floatBits(f);
+		if (back != x && x == x)
+		{
+			if (std::fabs(back) > std::fabs(x))
+				u--;
+			u |= 1;
+		}
+		return _bitsFloat(u);
+	}
+
+	template<class _To, class _From>
+	inline _To _saturateCast(_From x, integral_constant<int, 2>)
+	{
+		typedef typename std::conditional<is_floating_point<_From>::value
+			|| is_integral<_From>::value, _From, float>::type _Real;
+		//16λֻܴfloat죬ȵfloatһλ˫
+		//Ⱦȷתdouble(53λ)
+		if constexpr ((std::is_same<_To, Half>::value || std::is_same<_To, BFloat16>::value)
+			&& !std::is_same<_Real, float>::value)
+		{
+			typedef typename std::conditional<is_floating_point<_Real>::value, _Real, double>::type _Wide;
+			return _To(_narrowToOdd(static_cast<_Wide>(x)));
+		}
+		else
+			return static_cast<_To>(static_cast<_Real>(x));
+	}
+
+	template<class _To, class _From>
+	inline _To saturateCast(_From x)
+	{
+		return _saturateCast<_To>(x, _CastKind<_To, _From>());
+	}
+
+	//Ԫת_ToĿضϵΧ
+	template<class _To, class _From, class _Alloc>
+	Array2D<_To> convert(const Array2D<_From, _Alloc> &src)
+	{
+		size_t h = src.h(), w = src.w();
+		const _From *ps = src.data();
+		return _writeOnce<_To>(h, w, [=](_To *pd, size_t first, size_t last)
+		{
+			const _From *ARRARY_RESTRICT in = ps + first * w;
+			_To *ARRARY_RESTRICT out = pd + first * w;
+			for (size_t k = 0, n = (last - first) * w; k != n; k++)
+				out[k] = saturateCast<_To>(in[k]);
+		}, [=](size_t i, size_t j)
+		{
+			return saturateCast<_To>(ps[i * w + j]);
+		});
+	}
+
+	enum QuantGranularity
+	{
+		_PerTensor,		//һ
+		_PerRow			//ÿһ
+	};
+
+	struct QuantParams
+	{
+		float scale;
+		int zeroPoint;
+	};
+
+	template<typename _Q = signed char>
+	class QuantizedArray2D
+	{
+	public:
+		typedef QuantizedArray2D<_Q> _Myt;
+		typedef _Q value_type;
+		static_assert(is_integral<_Q>::value, "QuantizedArray2D only supports integral values");
+
+		//ݵСֵõΧǰ00Աȷʾ
+		template<class _Elem, class _Alloc>
+		explicit QuantizedArray2D(const Array2D<_Elem, _Alloc> &src,
+			QuantGranularity granularity = _PerTensor)
+			:_granularity(granularity), _values(src.h(), src.w()),
+			_params(granularity == _PerRow ? src.h() : 1)
+		{
+			size_t h = src.h(), w = src.w();
+			const _Elem *ps = src.data();
+			if (granularity == _PerRow)
+			{
+				QuantParams *pp = &_params[0];
+				forEachRowBlock(h, w, [=](size_t first, size_t last, size_t)
+				{
+					for (size_t i = first; i != last; i++)
+					{
+						pair<float, float> r = _range(ps + i * w, w);
+						pp[i] = computeParams(r.first, r.second);
+					}
+				});
+			}
+			else
+			{
+				std::vector<pair<float, float> > parts(std::thread::hardware_concurrency() + 1,
+					pair<float, float>(0.0f, 0.0f));
+				forEachRowBlock(h, w, [&](size_t first, size_t last, size_t block)
+				{
+					parts[block] = _range(ps + first * w, (last - first) * w);
+				});
+				float lo = 0.0f, hi = 0.0f;
+				for (size_t i = 0; i != parts.size(); i++)
+				{
+					lo = std::min(lo, parts[i].first);
+					hi = std::max(hi, parts[i].second);
+				}
+				_params[0] = computeParams(lo, hi);
+			}
+			_quantize(ps);
+		}
+
+		//ʹø
+		template<class _Elem, class _Alloc>
+		QuantizedArray2D(const Array2D<_Elem, _Alloc> &src, const QuantParams &params)
+			:_granularity(_PerTensor), _values(src.h(), src.w()),
+			_params(1, params)
+		{
+			if (!(params.scale > 0))
+				ARRARY_DEBUG_ERROR("the scale must be positive");
+			_quantize(src.data());
+		}
+
+		//[lo, hi]ӳ䵽_QΧ
+		static QuantParams computeParams(float lo, float hi)
+		{
+			typedef std::numeric_limits<_Q> _Lim;
+			float qmin = static_cast<float>(_Lim::min()), qmax = static_cast<float>(_Lim::max());
+			lo = std::min(lo, 0.0f);
+			hi = std::max(hi, 0.0f);
+			QuantParams p;
+			p.scale = hi > lo ? (hi - lo) / (qmax - qmin) : 1.0f;
+			p.zeroPoint = saturateCast<_Q>(qmin - lo / p.scale);
+			return p;
+		}
+
+		size_t h() const { return _values.h(); }
+
+		size_t w() const { return _values.w(); }
+
+		QuantGranularity granularity() const { return _granularity; }
+
+		//rowʹõĲ
+		const QuantParams &params(size_t row) const
+		{
+			if (row >= h())
+				ARRARY_DEBUG_ERROR("row out of range!");
+			return _params[_granularity == _PerRow ? row : 0];
+		}
+
+		//
+		const Array2D<_Q> &values() const
+		{
+			return _values;
+		}
+
+		float at(size_t row, size_t col) const
+		{
+			const QuantParams &p = params(row);
+			if (col >= w())
+				ARRARY_DEBUG_ERROR("column out of range!");
+			return (static_cast<float>(_values.data()[row * w() + col]) - p.zeroPoint) * p.scale;
+		}
+
+		template<class _To>
+		Array2D<_To> dequantize() const
+		{
+			size_t h = this->h(), w = this->w();
+			const _Q *pq = _values.data();
+			const QuantParams *pp = &_params[0];
+			size_t stride = _granularity == _PerRow ? 1 : 0;
+			return _writeOnce<_To>(h, w, [=](_To *pd, size_t first, size_t last)
+			{
+				for (size_t i = first; i != last; i++)
+				{
+					float scale = pp[i * stride].scale, zero = static_cast<float>(pp[i * stride].zeroPoint);
+					const _Q *ARRARY_RESTRICT in = pq + i * w;
+					_To *ARRARY_RESTRICT out = pd + i * w;
+					for (size_t j = 0; j != w; j++)
+						out[j] = saturateCast<_To>((static_cast<float>(in[j]) - zero) * scale);
+				}
+			}, [=](size_t i, size_t j)
+			{
+				const QuantParams &p = pp[i * stride];
+				return saturateCast<_To>((static_cast<float>(pq[i * w + j]) - p.zeroPoint) * p.scale);
+			});
+		}
+	private:
+		template<class _Elem>
+		static pair<float, float> _range(const _Elem *p, size_t n)
+		{
+			float lo = 0.0f, hi = 0.0f;
+			for (size_t i = 0; i != n; i++)
+			{
+				float v = static_cast<float>(p[i]);
+				lo = v < lo ? v : lo;
+				hi = v > hi ? v : hi;
+			}
+			return pair<float, float>(lo, hi);
+		}
+
+		//q = round(clamp(x / scale + zeroPoint))˶Ƚض䣬ûз֧
+		template<class _Elem>
+		void _quantize(const _Elem *ps)
+		{
+			size_t h = this->h(), w = this->w();
+			_Q *pq = _values._writableData();
+			const QuantParams *pp = &_params[0];
+			size_t stride = _granularity == _PerRow ? 1 : 0;
+			float qmin = static_cast<float>(std::numeric_limits<_Q>::min());
+			float qmax = static_cast<float>(std::numeric_limits<_Q>::max());
+			forEachRowBlock(h, w, [=](size_t first, size_t last, size_t)
+			{
+				for (size_t i = first; i != last; i++)
+				{
+					float inv = 1.0f / pp[i * stride].scale, zero = static_cast<float>(pp[i * stride].zeroPoint);
+					const _Elem *ARRARY_RESTRICT in = ps + i * w;
+					_Q *ARRARY_RESTRICT out = pq + i * w;
+					//outַʱͱհwȡֲѭȷ
+					for (size_t j = 0, n = w; j != n; j++)
+					{
+						float v = static_cast<float>(in[j]) * inv + zero;
+						v = v > qmin ? v : qmin;
+						v = v < qmax ? v : qmax;
+						out[j] = static_cast<_Q>(std::nearbyint(v));
+					}
+				}
+			});
+		}
+
+		QuantGranularity _granularity;
+		Array2D<_Q> _values;
+		std::vector<QuantParams> _params;
+	};
+}
+
+#endif // !ARRARY_CONVERT
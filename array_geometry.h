@@ -0,0 +1,195 @@
+/* Array2Dתͷת
+ * rotate90/rotate180/rotate270˳ʱ뷽flipHorizontalҷתflipVertical·ת
+ * ¶İ汾״ÿԪֻдһΣ
+ *   ԰ֽڸƵԪȷ䲻ʼĻɸп߳״д룬ҳfirst_touchͬ
+ *   Ԫذfrom_generator
+ * InPlace汾ֱӸдԭ󣺷תrotate180״rotate90/rotate270ֻǷ
+ * תķʰ_GeometryTileֿ飬ڵķת
+ * forEachRowBlockп鲢
+*/
+
+#ifndef ARRARY_GEOMETRY
+#define ARRARY_GEOMETRY
+
+#include "array.h"
+
+namespace arr
+{
+	const size_t _GeometryTile = 32;
+
+	//dst[rowBegin, rowEnd)Уdst(i, j) = src(srcRow(i, j), srcCol(i, j))
+	//srcжdstдʱڻ
+	template<class _Elem, class _Index>
+	void _tiledGather(const _Elem *ARRARY_RESTRICT src, size_t srcW, _Elem *ARRARY_RESTRICT dst, size_t dstW,
+		size_t rowBegin, size_t rowEnd, _Index index)
+	{
+		for (size_t bi = rowBegin; bi < rowEnd; bi += _GeometryTile)
+		{
+			size_t ei = std::min(bi + _GeometryTile, rowEnd);
+			for (size_t bj = 0; bj < dstW; bj += _GeometryTile)
+			{
+				size_t ej = std::min(bj + _GeometryTile, dstW);
+				for (size_t i = bi; i != ei; i++)
+				{
+					_Elem *out = dst + i * dstW;
+					for (size_t j = bj; j != ej; j++)
+					{
+						pair<size_t, size_t> s = index(i, j);
+						out[j] = src[s.first * srcW + s.second];
+					}
+				}
+			}
+		}
+	}
+
+	//dst(i, j) = src(index(i, j))Ϊh x w
+	//԰ֽڸʱkernel(pd, first, last)ֱдʼĻ[first, last)Уindex
+	template<class _Elem, class _Alloc, class _Kernel, class _Index>
+	Array2D<_Elem, _Alloc> _geometryResult(const Array2D<_Elem, _Alloc> &src, size_t h, size_t w,
+		_Kernel kernel, _Index index)
+	{
+		const _Elem *ps = src.data();
+		size_t srcW = src.w();
+		return _writeOnce<_Elem, _Alloc>(h, w, kernel, [=](size_t i, size_t j)
+		{
+			pair<size_t, size_t> s = index(i, j);
+			return ps[s.first * srcW + s.second];
+		});
+	}
+
+	//˳ʱת90ȣΪw() x h()
+	template<class _Elem, class _Alloc>
+	Array2D<_Elem, _Alloc> rotate90(const Array2D<_Elem, _Alloc> &src)
+	{
+		size_t h = src.h(), w = src.w();
+		const _Elem *ps = src.data();
+		auto index = [h](size_t i, size_t j)
+		{
+			return pair<size_t, size_t>(h - 1 - j, i);
+		};
+		return _geometryResult(src, w, h, [=](_Elem *pd, size_t first, size_t last)
+		{
+			_tiledGather(ps, w, pd, h, first, last, index);
+		}, index);
+	}
+
+	//ʱת90ȣΪw() x h()
+	template<class _Elem, class _Alloc>
+	Array2D<_Elem, _Alloc> rotate270(const Array2D<_Elem, _Alloc> &src)
+	{
+		size_t h = src.h(), w = src.w();
+		const _Elem *ps = src.data();
+		auto index = [w](size_t i, size_t j)
+		{
+			return pair<size_t, size_t>(j, w - 1 - i);
+		};
+		return _geometryResult(src, w, h, [=](_Elem *pd, size_t first, size_t last)
+		{
+			_tiledGather(ps, w, pd, h, first, last, index);
+		}, index);
+	}
+
+	template<class _Elem, class _Alloc>
+	Array2D<_Elem, _Alloc> rotate180(const Array2D<_Elem, _Alloc> &src)
+	{
+		size_t h = src.h(), w = src.w();
+		const _Elem *ps = src.data();
+		return _geometryResult(src, h, w, [=](_Elem *pd, size_t first, size_t last)
+		{
+			for (size_t i = first; i != last; i++)
+				std::reverse_copy(ps + (h - 1 - i) * w, ps + (h - i) * w, pd + i * w);
+		}, [h, w](size_t i, size_t j)
+		{
+			return pair<size_t, size_t>(h - 1 - i, w - 1 - j);
+		});
+	}
+
+	template<class _Elem, class _Alloc>
+	Array2D<_Elem, _Alloc> flipHorizontal(const Array2D<_Elem, _Alloc> &src)
+	{
+		size_t h = src.h(), w = src.w();
+		const _Elem *ps = src.data();
+		return _geometryResult(src, h, w, [=](_Elem *pd, size_t first, size_t last)
+		{
+			for (size_t i = first; i != last; i++)
+				std::reverse_copy(ps + i * w, ps + (i + 1) * w, pd + i * w);
+		}, [w](size_t i, size_t j)
+		{
+			return pair<size_t, size_t>(i, w - 1 - j);
+		});
+	}
+
+	template<class _Elem, class _Alloc>
+	Array2D<_Elem, _Alloc> flipVertical(const Array2D<_Elem, _Alloc> &src)
+	{
+		size_t h = src.h(), w = src.w();
+		const _Elem *ps = src.data();
+		return _geometryResult(src, h, w, [=](_Elem *pd, size_t first, size_t last)
+		{
+			for (size_t i = first; i != last; i++)
+				std::copy(ps + (h - 1 - i) * w, ps + (h - i) * w, pd + i * w);
+		}, [h](size_t i, size_t j)
+		{
+			return pair<size_t, size_t>(h - 1 - i, j);
+		});
+	}
+
+	template<class _Elem, class _Alloc>
+	void flipHorizontalInPlace(Array2D<_Elem, _Alloc> &a)
+	{
+		size_t h = a.h(), w = a.w();
+		_Elem *p = a._writableData();
+		forEachRowBlock(h, w, [=](size_t first, size_t last, size_t)
+		{
+			for (size_t i = first; i != last; i++)
+				std::reverse(p + i * w, p + (i + 1) * w);
+		});
+	}
+
+	//ih-1-iнֻϰ벿ַֿ
+	template<class _Elem, class _Alloc>
+	void flipVerticalInPlace(Array2D<_Elem, _Alloc> &a)
+	{
+		size_t h = a.h(), w = a.w();
+		_Elem *p = a._writableData();
+		forEachRowBlock(h / 2, w, [=](size_t first, size_t last, size_t)
+		{
+			for (size_t i = first; i != last; i++)
+				std::swap_ranges(p + i * w, p + (i + 1) * w, p + (h - 1 - i) * w);
+		});
+	}
+
+	template<class _Elem, class _Alloc>
+	void rotate180InPlace(Array2D<_Elem, _Alloc> &a)
+	{
+		flipVerticalInPlace(a);
+		flipHorizontalInPlace(a);
+	}
+
+	//ԭתãSquareMartrix::change_transposeSquare
+	template<class _Elem, class _Alloc>
+	void _transposeInPlace(Array2D<_Elem, _Alloc> &a)
+	{
+		if (a.h() != a.w())
+			ARRARY_DEBUG_ERROR("the object isn't the square matrix");
+		_transposeSquare(a._writableData(), a.w());
+	}
+
+	//ԭ˳ʱת90ȣתúҷת
+	template<class _Elem, class _Alloc>
+	void rotate90InPlace(Array2D<_Elem, _Alloc> &a)
+	{
+		_transposeInPlace(a);
+		flipHorizontalInPlace(a);
+	}
+
+	//ԭʱת90ȣתú·ת
+	template<class _Elem, class _Alloc>
+	void rotate270InPlace(Array2D<_Elem, _Alloc> &a)
+	{
+		_transposeInPlace(a);
+		flipVerticalInPlace(a);
+	}
+}
+
+#endif // !ARRARY_GEOMETRY
@@ -0,0 +1,197 @@
+/* HugePageAllocator
+ * 󻺳ʹ2MBҳķΪArray2D_Allocʹ
+ *   Array2D<double, HugePageAllocator<double> >
+ * ֵķȳMAP_HUGETLBʧʱ2MBӳͨҳmadvise(MADV_HUGEPAGE)
+ * ֵԼLinuxƽֱ̨ʹoperator new
+ * hugePageKindԲѯĳǰһַʽģ
+ *   MAP_HUGETLBɹʱһǴҳ͸ҳֻǷĺϲɴҳں˾
+ *   Ҫȷʱ/proc/self/smapsεַAnonHugePages
+*/
+
+#ifndef ARRARY_HUGEPAGE
+#define ARRARY_HUGEPAGE
+
+#include "array.h"
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <new>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace arr
+{
+	enum HugePageKind
+	{
+		_NormalPages,				//ͨ
+		_TransparentHugeRequested,	//madvise(MADV_HUGEPAGE)ɹֻ󣬲֤ʵǴҳ
+		_HugeTLB					//MAP_HUGETLBɹһǴҳ
+	};
+
+	//HugePageAllocatorֵѷ仺ļ¼
+	struct _HugePageRegistry
+	{
+		static const size_t _PageSize = size_t(2) << 20;
+
+		static std::atomic<size_t> &threshold()
+		{
+			static std::atomic<size_t> value(_PageSize);
+			return value;
+		}
+
+		static std::mutex &mutex()
+		{
+			static std::mutex m;
+			return m;
+		}
+
+		static std::map<const void *, HugePageKind> &blocks()
+		{
+			static std::map<const void *, HugePageKind> m;
+			return m;
+		}
+
+		static size_t roundUp(size_t bytes)
+		{
+			return (bytes + _PageSize - 1) / _PageSize * _PageSize;
+		}
+
+		static void *allocate(size_t bytes)
+		{
+#if defined(__linux__)
+			if (bytes >= threshold().load())
+			{
+				size_t len = roundUp(bytes);
+				HugePageKind kind = _HugeTLB;
+				void *p = mmap(0, len, PROT_READ | PROT_WRITE,
+					MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+				if (p == MAP_FAILED)
+				{
+					//ӳһҳ뵽2MB߽磬еβĲ
+					char *raw = static_cast<char *>(mmap(0, len + _PageSize, PROT_READ | PROT_WRITE,
+						MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+					if (raw == MAP_FAILED)
+						throw std::bad_alloc();
+					size_t head = (_PageSize - reinterpret_cast<size_t>(raw) % _PageSize) % _PageSize;
+					if (head)
+						munmap(raw, head);
+					munmap(raw + head + len, _PageSize - head);
+					p = raw + head;
+					kind = madvise(p, len, MADV_HUGEPAGE) == 0 ? _TransparentHugeRequested : _NormalPages;
+				}
+				std::lock_guard<std::mutex> lock(mutex());
+				blocks()[p] = kind;
+				return p;
+			}
+#endif
+			return ::operator new(bytes);
+		}
+
+		//ǼǼ¼жԴ֮޸ֵҲͷŴ
+		static void deallocate(void *p, size_t bytes)
+		{
+#if defined(__linux__)
+			bool mapped;
+			{
+				std::lock_guard<std::mutex> lock(mutex());
+				mapped = blocks().erase(p) != 0;
+			}
+			if (mapped)
+			{
+				munmap(p, roundUp(bytes));
+				return;
+			}
+#endif
+			(void)bytes;
+			::operator delete(p);
+		}
+
+		static HugePageKind kind(const void *p)
+		{
+			std::lock_guard<std::mutex> lock(mutex());
+			std::map<const void *, HugePageKind>::const_iterator it = blocks().find(p);
+			return it == blocks().end() ? _NormalPages : it->second;
+		}
+	};
+
+	template<typename _Ty>
+	class HugePageAllocator
+	{
+	public:
+		typedef _Ty value_type;
+		typedef _Ty *pointer;
+		typedef const _Ty *const_pointer;
+		typedef _Ty &reference;
+		typedef const _Ty &const_reference;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+
+		template<class _Other>
+		struct rebind
+		{
+			typedef HugePageAllocator<_Other> other;
+		};
+
+		HugePageAllocator() throw()
+		{ }
+
+		template<class _Other>
+		HugePageAllocator(const HugePageAllocator<_Other> &) throw()
+		{ }
+
+		pointer allocate(size_type n)
+		{
+			return static_cast<pointer>(_HugePageRegistry::allocate(n * sizeof(_Ty)));
+		}
+
+		void deallocate(pointer p, size_type n)
+		{
+			if (p)
+				_HugePageRegistry::deallocate(p, n * sizeof(_Ty));
+		}
+
+		template<class _Uty, class... _Args>
+		void construct(_Uty *p, const _Args &... args)
+		{
+			::new (static_cast<void *>(p)) _Uty(args...);
+		}
+
+		template<class _Uty>
+		void destroy(_Uty *p)
+		{
+			p->~_Uty();
+		}
+
+		//ֽķʹôҳĬ2MBHugePageAllocatorЧ
+		static void setThreshold(size_t bytes)
+		{
+			_HugePageRegistry::threshold().store(bytes);
+		}
+
+		static size_t threshold()
+		{
+			return _HugePageRegistry::threshold().load();
+		}
+
+		//pǱصĻ㣬&*array.cbegin()
+		static HugePageKind hugePageKind(const void *p)
+		{
+			return _HugePageRegistry::kind(p);
+		}
+	};
+
+	template<class _Ty, class _Other>
+	inline bool operator==(const HugePageAllocator<_Ty> &, const HugePageAllocator<_Other> &)
+	{
+		return true;
+	}
+
+	template<class _Ty, class _Other>
+	inline bool operator!=(const HugePageAllocator<_Ty> &, const HugePageAllocator<_Other> &)
+	{
+		return false;
+	}
+}
+
+#endif // !ARRARY_HUGEPAGE
@@ -0,0 +1,133 @@
+/* SummedAreaTable
+ * Array2DĻͼ(summed-area table)֮εĺֵO(1)
+ * Ϊ(h+1) x (w+1)0к͵00S(i, j) = ԭ[0, i) x [0, j)ĺ
+ * 飺вǰ׺ٰͣаһۼһ
+ * ԭĶmarkDirtyǼǸĶλãupdateֻӰ²
+ * ۼlong longdouble
+*/
+
+#ifndef ARRARY_INTEGRAL
+#define ARRARY_INTEGRAL
+
+#include "array.h"
+
+namespace arr
+{
+	template<typename _Elem,
+		typename _Acc = typename std::conditional<is_integral<_Elem>::value,
+			long long, decltype(_Elem() + 0.0)>::type>
+	class SummedAreaTable
+	{
+	public:
+		typedef SummedAreaTable<_Elem, _Acc> _Myt;
+		typedef _Elem value_type;
+		typedef _Acc sum_type;
+
+		template<class _Alloc>
+		explicit SummedAreaTable(const Array2D<_Elem, _Alloc> &src)
+			:_h(src.h()), _w(src.w()), _dirtyRow(0), _dirtyCol(0),
+			_table(src.h() + 1, src.w() + 1, first_touch, _Acc())
+		{
+			_rebuild(src.data(), 0, 0);
+		}
+
+		size_t h() const { return _h; }
+
+		size_t w() const { return _w; }
+
+		//[row0, row1) x [col0, col1)ĺ
+		_Acc sum(size_t row0, size_t col0, size_t row1, size_t col1) const
+		{
+			if (row0 > row1 || col0 > col1 || row1 > _h || col1 > _w)
+				ARRARY_DEBUG_ERROR("rectangle out of range!");
+			const _Acc *p = _table.data();
+			size_t tw = _w + 1;
+			return p[row1 * tw + col1] - p[row0 * tw + col1]
+				- p[row1 * tw + col0] + p[row0 * tw + col0];
+		}
+
+		double mean(size_t row0, size_t col0, size_t row1, size_t col1) const
+		{
+			if (row0 >= row1 || col0 >= col1)
+				ARRARY_DEBUG_ERROR("the rectangle is empty");
+			return static_cast<double>(sum(row0, col0, row1, col1))
+				/ static_cast<double>((row1 - row0) * (col1 - col0));
+		}
+
+		//ԭ[row0, row1) x [col0, col1)Ĺֻ¼Ͻǣupdate֮ǰѯĻǾֵ
+		void markDirty(size_t row0, size_t col0, size_t row1, size_t col1)
+		{
+			if (row0 >= row1 || col0 >= col1 || row1 > _h || col1 > _w)
+				ARRARY_DEBUG_ERROR("rectangle out of range!");
+			_dirtyRow = std::min(_dirtyRow, row0);
+			_dirtyCol = std::min(_dirtyCol, col0);
+		}
+
+		void markDirty(size_t row, size_t col)
+		{
+			markDirty(row, col, row + 1, col + 1);
+		}
+
+		bool isDirty() const
+		{
+			return _dirtyRow < _h;
+		}
+
+		//srcӰ쵽[dirtyRow + 1, h] x [dirtyCol + 1, w]
+		template<class _Alloc>
+		void update(const Array2D<_Elem, _Alloc> &src)
+		{
+			if (src.h() != _h || src.w() != _w)
+				ARRARY_DEBUG_ERROR("the object dimension isn't same as the table");
+			if (isDirty())
+				_rebuild(src.data(), _dirtyRow, _dirtyCol);
+		}
+
+		//ű(h+1) x (w+1)
+		const Array2D<_Acc> &table() const
+		{
+			return _table;
+		}
+	private:
+		//(row0, h](col0, w]row0к͵col0бǶԵ
+		//һS(i, j)дɵi-1[0, j)ĺͣڶмS(i-1, j)
+		void _rebuild(const _Elem *src, size_t row0, size_t col0)
+		{
+			size_t h = _h, w = _w, tw = _w + 1;
+			_Acc *ps = _table._writableData();
+			forEachRowBlock(h - row0, w - col0, [=](size_t first, size_t last, size_t)
+			{
+				for (size_t i = row0 + first + 1; i != row0 + last + 1; i++)
+				{
+					_Acc *out = ps + i * tw;
+					const _Elem *in = src + (i - 1) * w;
+					_Acc acc = out[col0] - (out - tw)[col0];
+					for (size_t j = col0; j != w; j++)
+					{
+						acc += static_cast<_Acc>(in[j]);
+						out[j + 1] = acc;
+					}
+				}
+			});
+			forEachRowBlock(w - col0, h - row0, [=](size_t first, size_t last, size_t)
+			{
+				for (size_t i = row0 + 1; i <= h; i++)
+				{
+					_Acc *ARRARY_RESTRICT out = ps + i * tw + col0 + 1;
+					const _Acc *ARRARY_RESTRICT up = out - tw;
+					for (size_t j = first; j != last; j++)
+						out[j] += up[j];
+				}
+			});
+			_dirtyRow = _h;
+			_dirtyCol = _w;
+		}
+
+		size_t _h, _w;
+		//ϽǣɾʱΪ(h, w)
+		size_t _dirtyRow, _dirtyCol;
+		Array2D<_Acc> _table;
+	};
+}
+
+#endif // !ARRARY_INTEGRAL
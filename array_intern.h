@@ -0,0 +1,77 @@
+/* InternPool
+ * ȥصArray2DأͬݵĶͬһдʱƵĻ
+ * Array2D::hash()ͰͰoperator==ȷ
+ * Ķ޸ʱճmakeCopyӰﱣİ汾
+*/
+
+#ifndef ARRARY_INTERN
+#define ARRARY_INTERN
+
+#include "array.h"
+#include <unordered_map>
+
+namespace arr
+{
+	template<typename _Array>
+	class InternPool
+	{
+	public:
+		typedef InternPool<_Array> _Myt;
+		typedef _Array value_type;
+
+		//valueͬĳڶĿûʱȷŽȥ
+		_Array intern(const _Array &value)
+		{
+			size_t h = value.hash();
+			typedef typename _Map::iterator _Iter;
+			pair<_Iter, _Iter> range = _pool.equal_range(h);
+			for (_Iter it = range.first; it != range.second; ++it)
+				if (it->second == value)
+					return it->second;
+			return _pool.insert(typename _Map::value_type(h, value))->second;
+		}
+
+		//ǷvalueͬĶ
+		bool contains(const _Array &value) const
+		{
+			typedef typename _Map::const_iterator _Iter;
+			pair<_Iter, _Iter> range = _pool.equal_range(value.hash());
+			for (_Iter it = range.first; it != range.second; ++it)
+				if (it->second == value)
+					return true;
+			return false;
+		}
+
+		//ֻԼõĶ󣬷ضĸ
+		size_t purge()
+		{
+			size_t n = 0;
+			for (typename _Map::iterator it = _pool.begin(); it != _pool.end();)
+			{
+				if (!it->second.isShared())
+				{
+					it = _pool.erase(it);
+					n++;
+				}
+				else
+					++it;
+			}
+			return n;
+		}
+
+		size_t size() const
+		{
+			return _pool.size();
+		}
+
+		void clear()
+		{
+			_pool.clear();
+		}
+	private:
+		typedef std::unordered_multimap<size_t, _Array> _Map;
+		_Map _pool;
+	};
+}
+
+#endif // !ARRARY_INTERN
@@ -0,0 +1,353 @@
+/* PackedMatrix
+ * ѹ洢ֻһǣn*(n+1)/2Ԫ
+ * _PackedLowerǾ󣬰дŵiе[0, i]
+ * _PackedUpperǾ󣬰дŵiе[i, n)
+ * _PackedSymmetricԳƾ󣬴ŷʽͬǣ(i, j)(j, i)ͬһԪ
+ * m[i][j]ܷһ£Ԫض0д
+ * multiplyֻ㲿֣forEachRowBlockп鲢
+*/
+
+#ifndef ARRARY_PACKED
+#define ARRARY_PACKED
+
+#include "array.h"
+#include <vector>
+
+namespace arr
+{
+	enum PackedKind
+	{
+		_PackedLower,
+		_PackedUpper,
+		_PackedSymmetric
+	};
+
+	//ǳm[i][j]صԪشʱ0дʱżλ
+	template<class _Owner>
+	class _PackedRef
+	{
+	public:
+		typedef typename _Owner::value_type _Elem;
+
+		_PackedRef(_Owner *owner, size_t row, size_t col)
+			:_owner(owner), _row(row), _col(col)
+		{ }
+
+		operator const _Elem &() const
+		{
+			return static_cast<const _Owner *>(_owner)->at(_row, _col);
+		}
+
+		_PackedRef &operator=(const _Elem &value)
+		{
+			_owner->at(_row, _col) = value;
+			return *this;
+		}
+
+		_PackedRef &operator=(const _PackedRef &rhs)
+		{
+			return *this = static_cast<const _Elem &>(rhs);
+		}
+
+		_PackedRef &operator+=(const _Elem &value)
+		{
+			_owner->at(_row, _col) += value;
+			return *this;
+		}
+
+		_PackedRef &operator-=(const _Elem &value)
+		{
+			_owner->at(_row, _col) -= value;
+			return *this;
+		}
+
+		_PackedRef &operator*=(const _Elem &value)
+		{
+			_owner->at(_row, _col) *= value;
+			return *this;
+		}
+
+		_PackedRef &operator/=(const _Elem &value)
+		{
+			_owner->at(_row, _col) /= value;
+			return *this;
+		}
+	private:
+		_Owner *_owner;
+		size_t _row, _col;
+	};
+
+	//m[i]صд
+	template<class _Owner>
+	class _PackedRow
+	{
+	public:
+		_PackedRow(_Owner *owner, size_t row)
+			:_owner(owner), _row(row)
+		{ }
+
+		_PackedRef<_Owner> operator[](size_t col) const
+		{
+			return _PackedRef<_Owner>(_owner, _row, col);
+		}
+	private:
+		_Owner *_owner;
+		size_t _row;
+	};
+
+	template<class _Owner>
+	class _PackedConstRow
+	{
+	public:
+		_PackedConstRow(const _Owner *owner, size_t row)
+			:_owner(owner), _row(row)
+		{ }
+
+		const typename _Owner::value_type &operator[](size_t col) const
+		{
+			return _owner->at(_row, col);
+		}
+	private:
+		const _Owner *_owner;
+		size_t _row;
+	};
+
+	template<typename _Elem, PackedKind _Kind, typename _Alloc = allocator<_Elem>>
+	class PackedMatrix
+	{
+	public:
+		typedef PackedMatrix<_Elem, _Kind, _Alloc> _Myt;
+		typedef PackedMatrix<_Elem, _Kind == _PackedLower ? _PackedUpper
+			: _Kind == _PackedUpper ? _PackedLower : _PackedSymmetric, _Alloc> transpose_type;
+		typedef SquareMartrix<_Elem, _Alloc> dense_type;
+		typedef _Elem value_type;
+		typedef size_t size_type;
+		typedef _Alloc allocator_type;
+		typedef _PackedRef<_Myt> reference;
+		typedef const _Elem &const_reference;
+		typedef _PackedRow<_Myt> row_type;
+		typedef _PackedConstRow<_Myt> const_row_type;
+
+		static const PackedKind kind = _Kind;
+
+		explicit PackedMatrix(size_t order = 3, const _Elem &value = _Elem())
+			:_n(order), _zero(), _data(order * (order + 1) / 2, value)
+		{
+			if (order == 0)
+				ARRARY_DEBUG_ERROR("dimension can not be zero!");
+		}
+
+		//ӳܷȡӦǣԳƾȡǣһǷԳ
+		template<class _OtherAlloc>
+		explicit PackedMatrix(const Array2D<_Elem, _OtherAlloc> &dense)
+			:_n(dense.w()), _zero(), _data(dense.w() * (dense.w() + 1) / 2)
+		{
+			if (dense.h() != dense.w())
+				ARRARY_DEBUG_ERROR("the object isn't the square matrix");
+			const _Elem *ps = dense.data();
+			_Elem *pd = data();
+			size_t n = _n;
+			forEachRowBlock(n, n / 2, [=](size_t first, size_t last, size_t)
+			{
+				for (size_t i = first; i != last; i++)
+				{
+					const _Elem *row = ps + i * n;
+					if (_Kind == _PackedUpper)
+						std::copy(row + i, row + n, pd + _offset(i, n));
+					else
+						std::copy(row, row + i + 1, pd + _offset(i, n));
+				}
+			});
+		}
+
+		//չɳܷ󣬰п鲢
+		dense_type toDense() const
+		{
+			const _Myt *self = this;
+			return dense_type(_n, from_generator, [self](size_t i, size_t j)
+			{
+				return self->at(i, j);
+			});
+		}
+
+		size_t order() const { return _n; }
+
+		//ʵʱԪظ
+		size_t size() const { return _data.size(); }
+
+		_Elem *data() { return &_data[0]; }
+
+		const _Elem *data() const { return &_data[0]; }
+
+		//(row, col)ѹ洢±꣬ⷵsize()
+		size_t index(size_t row, size_t col) const
+		{
+			if (_Kind == _PackedSymmetric && col > row)
+				std::swap(row, col);
+			if (_Kind == _PackedUpper ? col < row : col > row)
+				return _data.size();
+			return _offset(row, _n) + (_Kind == _PackedUpper ? col - row : col);
+		}
+
+		//Ԫزд
+		_Elem &at(size_t row, size_t col)
+		{
+			if (row >= _n || col >= _n)
+				ARRARY_DEBUG_ERROR("index out of range!");
+			size_t idx = index(row, col);
+			if (idx == _data.size())
+				ARRARY_DEBUG_ERROR("the element is outside the stored triangle");
+			return _data[idx];
+		}
+
+		const _Elem &at(size_t row, size_t col) const
+		{
+			if (row >= _n || col >= _n)
+				ARRARY_DEBUG_ERROR("index out of range!");
+			size_t idx = index(row, col);
+			return idx == _data.size() ? _zero : _data[idx];
+		}
+
+		row_type operator[](size_t row)
+		{
+			if (row >= _n)
+				ARRARY_DEBUG_ERROR("row out of range!");
+			return row_type(this, row);
+		}
+
+		const_row_type operator[](size_t row) const
+		{
+			if (row >= _n)
+				ARRARY_DEBUG_ERROR("row out of range!");
+			return const_row_type(this, row);
+		}
+
+		bool operator==(const _Myt &rhs) const
+		{
+			return _n == rhs._n && _data == rhs._data;
+		}
+
+		bool operator!=(const _Myt &rhs) const
+		{
+			return !(*this == rhs);
+		}
+
+		//ԳƾתþԼʲô
+		void change()
+		{
+			static_assert(_Kind == _PackedSymmetric,
+				"a triangular matrix changes its kind when transposed, use transposed()");
+		}
+
+		transpose_type transposed() const
+		{
+			transpose_type result(_n);
+			for (size_t i = 0; i != _n; i++)
+				for (size_t j = 0; j != _n; j++)
+				{
+					size_t idx = index(i, j);
+					if (idx != _data.size())
+						result.at(j, i) = _data[idx];
+				}
+			return result;
+		}
+
+		//(*this) * rhsrhsn x mĳ飬ֻķ㲿
+		//ĵi = sum(this(i, k) * rhsĵk)ڲеĳ˼
+		template<class _OtherAlloc>
+		Array2D<_Elem, _OtherAlloc> multiply(const Array2D<_Elem, _OtherAlloc> &rhs) const
+		{
+			if (rhs.h() != _n)
+				ARRARY_DEBUG_ERROR("the object dimension isn't same as the object multiplied");
+			size_t n = _n, m = rhs.w();
+			Array2D<_Elem, _OtherAlloc> result(n, m, first_touch, _Elem());
+			const _Elem *pa = data(), *pb = rhs.data();
+			_Elem *pc = result._writableData();
+			forEachRowBlock(n, n * m / 2, [=](size_t first, size_t last, size_t)
+			{
+				for (size_t i = first; i != last; i++)
+				{
+					_Elem *ARRARY_RESTRICT out = pc + i * m;
+					size_t kb = _Kind == _PackedUpper ? i : 0;
+					size_t ke = _Kind == _PackedLower ? i + 1 : n;
+					for (size_t k = kb; k != ke; k++)
+					{
+						//Գƾk > iĲִӵkȡ
+						_Elem a = pa[_Kind == _PackedUpper ? _offset(i, n) + k - i
+							: k <= i ? _offset(i, n) + k : _offset(k, n) + i];
+						const _Elem *ARRARY_RESTRICT in = pb + k * m;
+						for (size_t j = 0; j != m; j++)
+							out[j] += a * in[j];
+					}
+				}
+			});
+			return result;
+		}
+
+		//ͬǾˣͬǾ
+		//ǣiе[0, k] += this(i, k) * rhskе[0, k]k <= i
+		//ǣiе[k, n) += this(i, k) * rhskе[k, n)k >= i
+		_Myt multiply(const _Myt &rhs) const
+		{
+			static_assert(_Kind != _PackedSymmetric,
+				"the product of symmetric matrices isn't symmetric, multiply by toDense()");
+			if (rhs._n != _n)
+				ARRARY_DEBUG_ERROR("the object dimension isn't same as the object multiplied");
+			size_t n = _n;
+			_Myt result(n);
+			const _Elem *pa = data(), *pb = rhs.data();
+			_Elem *pc = result.data();
+			forEachRowBlock(n, n * n / 4, [=](size_t first, size_t last, size_t)
+			{
+				for (size_t i = first; i != last; i++)
+				{
+					const _Elem *arow = pa + _offset(i, n);
+					_Elem *ARRARY_RESTRICT out = pc + _offset(i, n);
+					if (_Kind == _PackedLower)
+					{
+						for (size_t k = 0; k <= i; k++)
+						{
+							const _Elem *ARRARY_RESTRICT in = pb + _offset(k, n);
+							_Elem a = arow[k];
+							for (size_t j = 0; j <= k; j++)
+								out[j] += a * in[j];
+						}
+					}
+					else
+					{
+						for (size_t k = i; k != n; k++)
+						{
+							const _Elem *ARRARY_RESTRICT in = pb + _offset(k, n);
+							_Elem a = arow[k - i];
+							_Elem *ARRARY_RESTRICT dst = out + (k - i);
+							for (size_t j = 0, len = n - k; j != len; j++)
+								dst[j] += a * in[j];
+						}
+					}
+				}
+			});
+			return result;
+		}
+	private:
+		//rowѹ洢
+		static size_t _offset(size_t row, size_t n)
+		{
+			return _Kind == _PackedUpper ? row * (2 * n - row + 1) / 2 : row * (row + 1) / 2;
+		}
+
+		size_t _n;
+		_Elem _zero;
+		std::vector<_Elem, _Alloc> _data;
+	};
+
+	template<typename _Elem, typename _Alloc = allocator<_Elem>>
+	using SymmetricMatrix = PackedMatrix<_Elem, _PackedSymmetric, _Alloc>;
+
+	template<typename _Elem, typename _Alloc = allocator<_Elem>>
+	using LowerTriangularMatrix = PackedMatrix<_Elem, _PackedLower, _Alloc>;
+
+	template<typename _Elem, typename _Alloc = allocator<_Elem>>
+	using UpperTriangularMatrix = PackedMatrix<_Elem, _PackedUpper, _Alloc>;
+}
+
+#endif // !ARRARY_PACKED
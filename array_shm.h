@@ -0,0 +1,217 @@
+/* SharedArray2D
+ * ͨPOSIXڴ(shm_open + mmap)ڽ֮㿽عArray2DֻPOSIXϵͳ
+ * εĿͷһҳͷ״ԪͺͿ̵ü֮Ԫ
+ *   publishΪnameĶβݸƽȥ
+ *   attachӳеĶΣ
+ * ߷صArray2DֱӶڴ(ҳֻ)һдʱдʱưᵽ˽ڴ
+ * ÿŵArray2Dռһãһŵʱɾ(publishʱѡ)
+ * 쳣˳ʱռò黹removeֶɾ
+*/
+
+#ifndef ARRARY_SHM
+#define ARRARY_SHM
+
+#include "array.h"
+#include <atomic>
+#include <cerrno>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace arr
+{
+	struct _ShmHeader
+	{
+		static const unsigned long long _Magic = 0x31304d4853443241ull;	//"A2DSHM01"
+
+		unsigned long long magic;
+		unsigned long long h, w, elemSize, typeCode, dataOffset;
+		std::atomic<long long> refCount;
+		std::atomic<unsigned> ready;	//д1
+		unsigned removeWhenUnused;
+	};
+
+	static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+		"interprocess reference count needs lock-free atomics");
+
+	template<typename _Elem>
+	class SharedArray2D
+	{
+	public:
+		typedef Array2D<_Elem> array_type;
+
+		//ΪnameĶ(Ѵʱʧ)srcعڶϵֻArray2D
+		//removeWhenUnusedΪfalseʱһ÷ŵȻֱremove
+		template<class _Alloc>
+		static array_type publish(const std::string &name, const Array2D<_Elem, _Alloc> &src,
+			bool removeWhenUnused = true)
+		{
+			static_assert(is_trivially_copyable<_Elem>::value,
+				"SharedArray2D only supports trivially copyable elements");
+			size_t h = src.h(), w = src.w();
+			size_t offset = _dataOffset(), length = offset + h * w * sizeof(_Elem);
+			int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+			if (fd < 0)
+				_throwErrno(errno, "shm_open " + name);
+			if (ftruncate(fd, static_cast<off_t>(length)) != 0)
+			{
+				int err = errno;
+				close(fd);
+				shm_unlink(name.c_str());
+				_throwErrno(err, "ftruncate " + name);
+			}
+			char *base = _map(fd, length, name, true);
+
+			_ShmHeader *hdr = new (base) _ShmHeader();
+			hdr->magic = _ShmHeader::_Magic;
+			hdr->h = h;
+			hdr->w = w;
+			hdr->elemSize = sizeof(_Elem);
+			hdr->typeCode = _typeCode();
+			hdr->dataOffset = offset;
+			hdr->removeWhenUnused = removeWhenUnused;
+			hdr->refCount.store(1);
+
+			const _Elem *ps = src.data();
+			_Elem *pd = reinterpret_cast<_Elem *>(base + offset);
+			forEachRowBlock(h, w, [=](size_t first, size_t last, size_t)
+			{
+				std::memcpy(pd + first * w, ps + first * w, (last - first) * w * sizeof(_Elem));
+			});
+			hdr->ready.store(1, std::memory_order_release);
+			return _wrap(base, length, name);
+		}
+
+		//ӳеĶΣ״Ԫͱ_Elemһ
+		static array_type attach(const std::string &name)
+		{
+			int fd = shm_open(name.c_str(), O_RDWR, 0);
+			if (fd < 0)
+				_throwErrno(errno, "shm_open " + name);
+			struct stat st;
+			if (fstat(fd, &st) != 0)
+			{
+				int err = errno;
+				close(fd);
+				_throwErrno(err, "fstat " + name);
+			}
+			size_t length = static_cast<size_t>(st.st_size);
+			if (length < _dataOffset())
+			{
+				close(fd);
+				throw std::runtime_error("broken header in shared memory " + name);
+			}
+			char *base = _map(fd, length, name, false);
+
+			_ShmHeader *hdr = reinterpret_cast<_ShmHeader *>(base);
+			const char *error = 0;
+			if (hdr->magic != _ShmHeader::_Magic || hdr->dataOffset != _dataOffset()
+				|| !_fits(hdr->h, hdr->w, hdr->elemSize, length - _dataOffset()))
+				error = "broken header in shared memory ";
+			else if (hdr->ready.load(std::memory_order_acquire) == 0)
+				error = "unfinished shared memory ";
+			else if (hdr->elemSize != sizeof(_Elem) || hdr->typeCode != _typeCode())
+				error = "element type isn't same as the shared memory ";
+			else
+			{
+				//ԶɾĶμѾ㣬˵ڱɾٹȥ
+				long long n = hdr->refCount.load();
+				do
+				{
+					if (n <= 0 && hdr->removeWhenUnused)
+					{
+						error = "released shared memory ";
+						break;
+					}
+				} while (!hdr->refCount.compare_exchange_weak(n, n + 1));
+			}
+			if (error)
+			{
+				munmap(base, length);
+				throw std::runtime_error(error + name);
+			}
+			return _wrap(base, length, name);
+		}
+
+		//ɾ֣ѾӳĽ̲Ӱ
+		static bool remove(const std::string &name)
+		{
+			return shm_unlink(name.c_str()) == 0;
+		}
+	private:
+		static size_t _dataOffset()
+		{
+			size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+			return (sizeof(_ShmHeader) + page - 1) / page * page;
+		}
+
+		//޷źʹСԪ֮ͣͬҲȶ
+		static unsigned long long _typeCode()
+		{
+			unsigned long long kind = is_floating_point<_Elem>::value ? 2
+				: is_integral<_Elem>::value ? (std::is_signed<_Elem>::value ? 1 : 0) : 3;
+			return kind << 32 | sizeof(_Elem);
+		}
+
+		static void _throwErrno(int err, const std::string &what)
+		{
+			throw std::system_error(err, std::generic_category(), what);
+		}
+
+		static char *_map(int fd, size_t length, const std::string &name, bool created)
+		{
+			void *p = mmap(0, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			int err = errno;
+			close(fd);
+			if (p == MAP_FAILED)
+			{
+				if (created)
+					shm_unlink(name.c_str());
+				_throwErrno(err, "mmap " + name);
+			}
+			return static_cast<char *>(p);
+		}
+
+		//h * w * elemSizeֽڷŵýbodyóȽϣͷó˷
+		static bool _fits(unsigned long long h, unsigned long long w, unsigned long long elemSize,
+			unsigned long long body)
+		{
+			return h != 0 && w != 0 && elemSize != 0 && w <= body / elemSize / h;
+		}
+
+		//ҳֻһ÷ŵʱӳ䡢黹̵ļ
+		static array_type _wrap(char *base, size_t length, const std::string &name)
+		{
+			_ShmHeader *hdr = reinterpret_cast<_ShmHeader *>(base);
+			size_t offset = static_cast<size_t>(hdr->dataOffset);
+			std::function<void()> release = [base, length, name]()
+			{
+				_ShmHeader *head = reinterpret_cast<_ShmHeader *>(base);
+				bool remove = head->removeWhenUnused != 0;
+				bool last = head->refCount.fetch_sub(1) == 1;
+				munmap(base, length);
+				if (last && remove)
+					shm_unlink(name.c_str());
+			};
+			try
+			{
+				if (length > offset)
+					mprotect(base + offset, length - offset, PROT_READ);
+				return array_type(static_cast<size_t>(hdr->h), static_cast<size_t>(hdr->w),
+					external_buffer, reinterpret_cast<const _Elem *>(base + offset), release);
+			}
+			catch (...)
+			{
+				release();
+				throw;
+			}
+		}
+	};
+}
+
+#endif // !ARRARY_SHM
@@ -0,0 +1,163 @@
+/* SnapshotCell
+ * дĿշ߲
+ * ͨhazard pointerǼʹõİ汾д߷°汾Ѿɰ汾Ž
+ * ûκζߵǼǵݰ汾ű
+ * _RCPtrüûм԰汾ֻд߳ϸƺ
+ * ֻͨӿڷʿգҪѿArray2D
+*/
+
+#ifndef ARRARY_SNAPSHOT
+#define ARRARY_SNAPSHOT
+
+#include "array.h"
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace arr
+{
+	template<typename _Ty, size_t _Slots = 128>
+	class SnapshotCell
+	{
+		struct _Node
+		{
+			explicit _Node(const _Ty &value)
+				:_value(value)
+			{ }
+
+			_Ty _value;
+		};
+	public:
+		typedef SnapshotCell<_Ty, _Slots> _Myt;
+		typedef _Ty value_type;
+
+		//߳еĿգʱǼ
+		class Snapshot
+		{
+			friend class SnapshotCell;
+		public:
+			Snapshot(Snapshot &&rhs)
+				:_slot(rhs._slot)
+			{
+				rhs._slot = 0;
+			}
+
+			~Snapshot()
+			{
+				if (_slot)
+					_slot->store(0);
+			}
+
+			const _Ty &operator*() const
+			{
+				return _slot->load()->_value;
+			}
+
+			const _Ty *operator->() const
+			{
+				return &_slot->load()->_value;
+			}
+		private:
+			explicit Snapshot(std::atomic<_Node *> *slot)
+				:_slot(slot)
+			{ }
+
+			Snapshot(const Snapshot &);
+			Snapshot &operator=(const Snapshot &);
+
+			std::atomic<_Node *> *_slot;
+		};
+
+		explicit SnapshotCell(const _Ty &value)
+			:_current(new _Node(value))
+		{
+			for (size_t i = 0; i != _Slots; i++)
+				_hazard[i].store(0);
+		}
+
+		//ʱдĿ
+		~SnapshotCell()
+		{
+			delete _current.load();
+			for (size_t i = 0; i != _retired.size(); i++)
+				delete _retired[i];
+		}
+
+		//ȡǰ汾
+		Snapshot acquire() const
+		{
+			size_t start = std::hash<std::thread::id>()(std::this_thread::get_id()) % _Slots;
+			for (;;)
+			{
+				for (size_t n = 0; n != _Slots; n++)
+				{
+					std::atomic<_Node *> &slot = _hazard[(start + n) % _Slots];
+					_Node *p = _current.load();
+					_Node *expected = 0;
+					if (!slot.compare_exchange_strong(expected, p))
+						continue;
+					//Ǽ֮ȷһΣ֤дܿεǼ
+					_Node *q;
+					while ((q = _current.load()) != p)
+					{
+						slot.store(q);
+						p = q;
+					}
+					return Snapshot(&slot);
+				}
+				std::this_thread::yield();
+			}
+		}
+
+		//°汾value߹д´޸ʱŻmakeCopy
+		void publish(const _Ty &value)
+		{
+			_Node *fresh = new _Node(value);
+			std::lock_guard<std::mutex> lock(_writerMutex);
+			_retired.push_back(_current.exchange(fresh));
+			_reclaim();
+		}
+
+		//Ѿûжߵľɰ汾δյİ汾
+		size_t reclaim()
+		{
+			std::lock_guard<std::mutex> lock(_writerMutex);
+			_reclaim();
+			return _retired.size();
+		}
+	private:
+		SnapshotCell(const _Myt &);
+		_Myt &operator=(const _Myt &);
+
+		void _reclaim()
+		{
+			std::vector<_Node *> busy;
+			for (size_t i = 0; i != _Slots; i++)
+			{
+				_Node *p = _hazard[i].load();
+				if (p)
+					busy.push_back(p);
+			}
+			std::sort(busy.begin(), busy.end());
+
+			size_t kept = 0;
+			for (size_t i = 0; i != _retired.size(); i++)
+			{
+				if (std::binary_search(busy.begin(), busy.end(), _retired[i]))
+					_retired[kept++] = _retired[i];
+				else
+					delete _retired[i];
+			}
+			_retired.resize(kept);
+		}
+
+		std::atomic<_Node *> _current;
+		mutable std::atomic<_Node *> _hazard[_Slots];
+		std::vector<_Node *> _retired;
+		std::mutex _writerMutex;
+	};
+}
+
+#endif // !ARRARY_SNAPSHOT
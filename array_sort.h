@@ -0,0 +1,153 @@
+/* Array2DĲ
+ * parallelSort򣬸鲢鲢
+ * sortEachRowÿһж
+ * sortRowsByColumn/sortRowsLexicographicΪλ
+ *   ȶкõûһΰоۼţУֻдһ
+ * ֿ鶼forEachRowBlockСֱڵ߳
+*/
+
+#ifndef ARRARY_SORT
+#define ARRARY_SORT
+
+#include "array.h"
+#include <functional>
+#include <vector>
+
+namespace arr
+{
+	//[p, p + n)ֿ鲢stableΪʱȶ
+	template<class _Ty, class _Comp>
+	void _parallelSortRange(_Ty *p, size_t n, _Comp comp, bool stable)
+	{
+		std::vector<pair<size_t, size_t> > runs(std::thread::hardware_concurrency() + 1,
+			pair<size_t, size_t>(n, n));
+		forEachRowBlock(n, 1, [&](size_t first, size_t last, size_t block)
+		{
+			if (stable)
+				std::stable_sort(p + first, p + last, comp);
+			else
+				std::sort(p + first, p + last, comp);
+			runs[block] = pair<size_t, size_t>(first, last);
+		});
+		std::sort(runs.begin(), runs.end());
+		while (!runs.empty() && runs.back().first == n)
+			runs.pop_back();
+
+		//ÿһڵι鲢һΣ鲢ȶ
+		while (runs.size() > 1)
+		{
+			size_t pairs = runs.size() / 2;
+			forEachRowBlock(pairs, n / pairs, [&](size_t first, size_t last, size_t)
+			{
+				for (size_t k = first; k != last; k++)
+					std::inplace_merge(p + runs[2 * k].first, p + runs[2 * k].second,
+						p + runs[2 * k + 1].second, comp);
+			});
+			std::vector<pair<size_t, size_t> > next;
+			for (size_t k = 0; k != pairs; k++)
+				next.push_back(pair<size_t, size_t>(runs[2 * k].first, runs[2 * k + 1].second));
+			if (runs.size() % 2)
+				next.push_back(runs.back());
+			runs.swap(next);
+		}
+	}
+
+	template<class _Elem, class _Alloc, class _Comp>
+	void parallelSort(Array2D<_Elem, _Alloc> &a, _Comp comp)
+	{
+		_parallelSortRange(a._writableData(), a.size(), comp, false);
+	}
+
+	template<class _Elem, class _Alloc>
+	void parallelSort(Array2D<_Elem, _Alloc> &a)
+	{
+		parallelSort(a, std::less<_Elem>());
+	}
+
+	template<class _Elem, class _Alloc, class _Comp>
+	void sortEachRow(Array2D<_Elem, _Alloc> &a, _Comp comp)
+	{
+		size_t w = a.w();
+		_Elem *p = a._writableData();
+		forEachRowBlock(a.h(), w, [=](size_t first, size_t last, size_t)
+		{
+			for (size_t i = first; i != last; i++)
+				std::sort(p + i * w, p + (i + 1) * w, comp);
+		});
+	}
+
+	template<class _Elem, class _Alloc>
+	void sortEachRow(Array2D<_Elem, _Alloc> &a)
+	{
+		sortEachRow(a, std::less<_Elem>());
+	}
+
+	//permУµĵiԭĵperm[i]
+	template<class _Elem, class _Alloc>
+	void permuteRows(Array2D<_Elem, _Alloc> &a, const std::vector<size_t> &perm)
+	{
+		size_t h = a.h(), w = a.w();
+		if (perm.size() != h)
+			ARRARY_DEBUG_ERROR("the permutation size isn't same as the rows");
+		for (size_t i = 0; i != h; i++)
+			if (perm[i] >= h)
+				ARRARY_DEBUG_ERROR("row out of range!");
+		//һξۼÿԪֻдһ
+		const _Elem *ps = static_cast<const Array2D<_Elem, _Alloc> &>(a).data();
+		const size_t *pp = &perm[0];
+		a = _writeOnce<_Elem, _Alloc>(h, w, [=](_Elem *pd, size_t first, size_t last)
+		{
+			for (size_t i = first; i != last; i++)
+				std::copy(ps + pp[i] * w, ps + (pp[i] + 1) * w, pd + i * w);
+		}, [=](size_t i, size_t j)
+		{
+			return ps[pp[i] * w + j];
+		});
+	}
+
+	//кŵȶcomp(i, j)Ƚϵiк͵j
+	template<class _Elem, class _Alloc, class _RowComp>
+	std::vector<size_t> rowOrder(const Array2D<_Elem, _Alloc> &a, _RowComp comp)
+	{
+		std::vector<size_t> perm(a.h());
+		for (size_t i = 0; i != perm.size(); i++)
+			perm[i] = i;
+		_parallelSortRange(&perm[0], perm.size(), comp, true);
+		return perm;
+	}
+
+	//ԵcolΪȶ
+	template<class _Elem, class _Alloc, class _Comp>
+	void sortRowsByColumn(Array2D<_Elem, _Alloc> &a, size_t col, _Comp comp)
+	{
+		if (col >= a.w())
+			ARRARY_DEBUG_ERROR("column out of range!");
+		const _Elem *p = static_cast<const Array2D<_Elem, _Alloc> &>(a).data() + col;
+		size_t w = a.w();
+		permuteRows(a, rowOrder(a, [=](size_t i, size_t j)
+		{
+			return comp(p[i * w], p[j * w]);
+		}));
+	}
+
+	template<class _Elem, class _Alloc>
+	void sortRowsByColumn(Array2D<_Elem, _Alloc> &a, size_t col)
+	{
+		sortRowsByColumn(a, col, std::less<_Elem>());
+	}
+
+	//ֵȶ
+	template<class _Elem, class _Alloc>
+	void sortRowsLexicographic(Array2D<_Elem, _Alloc> &a)
+	{
+		const _Elem *p = static_cast<const Array2D<_Elem, _Alloc> &>(a).data();
+		size_t w = a.w();
+		permuteRows(a, rowOrder(a, [=](size_t i, size_t j)
+		{
+			return std::lexicographical_compare(p + i * w, p + (i + 1) * w,
+				p + j * w, p + (j + 1) * w);
+		}));
+	}
+}
+
+#endif // !ARRARY_SORT
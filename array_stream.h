@@ -0,0 +1,155 @@
+/* Array2Dʽд
+ * ļʽͷ(h, w, sizeof(_Elem)8ֽ)֮Ԫ
+ * Array2DReaderпȡ̨߳Ԥһ飬صǰʱI/Oͬʱ
+ * ڴռֻп飬ʺϱڴ滹ľ
+ * ֻֿ֧԰ֽڸ(trivially copyable)Ԫ
+ * ļݺͷԲϡдԶI/O׳std::ios_base::failure
+*/
+
+#ifndef ARRARY_STREAM
+#define ARRARY_STREAM
+
+#include "array.h"
+#include <fstream>
+#include <future>
+#include <string>
+#include <vector>
+
+namespace arr
+{
+	struct _StreamHeader
+	{
+		unsigned long long _h, _w, _elemSize;
+	};
+
+	template<typename _Elem>
+	class Array2DReader
+	{
+	public:
+		typedef Array2DReader<_Elem> _Myt;
+		typedef _Elem value_type;
+
+		explicit Array2DReader(const std::string &path)
+			:_in(path.c_str(), std::ios::binary)
+		{
+			static_assert(is_trivially_copyable<_Elem>::value, "Array2DReader only supports trivially copyable elements");
+			if (!_in)
+				throw std::ios_base::failure("can not open " + path);
+			_StreamHeader head;
+			if (!_in.read(reinterpret_cast<char *>(&head), sizeof(head)))
+				throw std::ios_base::failure("broken header in " + path);
+			if (head._elemSize != sizeof(_Elem))
+				throw std::ios_base::failure("element size of " + path + " isn't same as the element type");
+			//ļȱͷh * wԪأóȽϣͷó˷
+			_in.seekg(0, std::ios::end);
+			unsigned long long body = static_cast<unsigned long long>(_in.tellg()) - sizeof(head);
+			if (head._h == 0 || head._w == 0 || head._w > body / sizeof(_Elem)
+				|| body % (head._w * sizeof(_Elem)) != 0 || body / (head._w * sizeof(_Elem)) != head._h)
+				throw std::ios_base::failure("file size of " + path + " isn't same as the header");
+			_h = static_cast<size_t>(head._h);
+			_w = static_cast<size_t>(head._w);
+		}
+
+		size_t h() const { return _h; }
+
+		size_t w() const { return _w; }
+
+		//rowsPerBlockһεf(firstRow, rows, data, w)
+		//dataֻڱλصЧصʱһѾں̨ȡ
+		template<class _Fn>
+		void forEachBlock(size_t rowsPerBlock, _Fn f)
+		{
+			if (rowsPerBlock == 0)
+				ARRARY_DEBUG_ERROR("block size can not be zero!");
+			rowsPerBlock = std::min(rowsPerBlock, _h);
+			std::vector<_Elem> buf[2];
+			buf[0].resize(rowsPerBlock * _w);
+			buf[1].resize(rowsPerBlock * _w);
+
+			size_t row = 0, rows = rowsPerBlock;
+			std::future<void> pending = std::async(std::launch::async,
+				&_Myt::_readBlock, this, buf[0].data(), row, rows);
+			for (int cur = 0; rows != 0; cur ^= 1)
+			{
+				pending.get();
+				size_t nextRow = row + rows;
+				size_t nextRows = std::min(rowsPerBlock, _h - nextRow);
+				if (nextRows != 0)
+					pending = std::async(std::launch::async,
+						&_Myt::_readBlock, this, buf[cur ^ 1].data(), nextRow, nextRows);
+				//ص쳣ʱpendingȴ̨ȡ
+				f(row, rows, static_cast<const _Elem *>(buf[cur].data()), _w);
+				row = nextRow;
+				rows = nextRows;
+			}
+		}
+	private:
+		void _readBlock(_Elem *dst, size_t row, size_t rows)
+		{
+			std::streamoff off = sizeof(_StreamHeader)
+				+ static_cast<std::streamoff>(row) * _w * sizeof(_Elem);
+			_in.seekg(off);
+			if (!_in.read(reinterpret_cast<char *>(dst), rows * _w * sizeof(_Elem)))
+				throw std::ios_base::failure("unexpected end of file");
+		}
+
+		std::ifstream _in;
+		size_t _h, _w;
+	};
+
+	template<typename _Elem>
+	class Array2DWriter
+	{
+	public:
+		typedef _Elem value_type;
+
+		Array2DWriter(const std::string &path, size_t h, size_t w)
+			:_out(path.c_str(), std::ios::binary | std::ios::trunc), _h(h), _w(w), _written(0)
+		{
+			static_assert(is_trivially_copyable<_Elem>::value, "Array2DWriter only supports trivially copyable elements");
+			if (h == 0 || w == 0)
+				ARRARY_DEBUG_ERROR("dimension can not be zero!");
+			if (!_out)
+				throw std::ios_base::failure("can not open " + path);
+			_StreamHeader head = { h, w, sizeof(_Elem) };
+			_out.write(reinterpret_cast<const char *>(&head), sizeof(head));
+		}
+
+		size_t h() const { return _h; }
+
+		size_t w() const { return _w; }
+
+		size_t rowsWritten() const { return _written; }
+
+		//׷rowsУdataÿw()Ԫ
+		void write(const _Elem *data, size_t rows)
+		{
+			if (rows > _h - _written)
+				throw std::ios_base::failure("rows written exceed the file height");
+			if (!_out.write(reinterpret_cast<const char *>(data), rows * _w * sizeof(_Elem)))
+				throw std::ios_base::failure("write failed");
+			_written += rows;
+		}
+
+		template<class _Alloc>
+		void write(const Array2D<_Elem, _Alloc> &block)
+		{
+			if (block.w() != _w)
+				throw std::ios_base::failure("the block width isn't same as the file");
+			write(&*block.begin(), block.h());
+		}
+
+		//ʱļȻرգǲ
+		void close()
+		{
+			_out.close();
+			if (_written != _h)
+				throw std::ios_base::failure("rows written isn't same as the file");
+		}
+	private:
+		std::ofstream _out;
+		size_t _h, _w, _written;
+	};
+}
+
+#endif // !ARRARY_STREAM
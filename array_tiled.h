@@ -0,0 +1,192 @@
+/* TiledArray2D
+ * ֿ洢Ķά飬ÿһ鶼ǴдʱƵ_RCObject
+ * ֻƿָ룬дʱֻƱдһ
+ * ÿһǣԲѯϴclearDirtyдĿ飬ͬл
+*/
+
+#ifndef ARRARY_TILED
+#define ARRARY_TILED
+
+#include "array.h"
+#include <vector>
+
+namespace arr
+{
+	template<typename _Elem,
+		typename _Alloc = allocator<_Elem>>
+	class TiledArray2D
+	{
+		struct _Tile :
+			public _RCObject<_Tile>
+		{
+			_Tile(size_t h, size_t w, const _Elem &value)
+				:_w(w), _data(h * w, value)
+			{ }
+
+			~_Tile()
+			{ }
+
+			size_t _w;
+			std::vector<_Elem, _Alloc> _data;
+		};
+	public:
+		typedef TiledArray2D<_Elem, _Alloc> _Myt;
+		typedef _Elem value_type;
+		typedef size_t size_type;
+		typedef _Alloc allocator_type;
+
+		TiledArray2D(size_t h, size_t w, size_t tileSize = 64, const _Elem &value = _Elem())
+			:_h(h), _w(w), _ts(tileSize)
+		{
+			if (h == 0 || w == 0 || tileSize == 0)
+				ARRARY_DEBUG_ERROR("dimension can not be zero!");
+			_th = (h + _ts - 1) / _ts;
+			_tw = (w + _ts - 1) / _ts;
+			_tiles.reserve(_th * _tw);
+			for (size_t i = 0; i != _th; i++)
+				for (size_t j = 0; j != _tw; j++)
+					_tiles.push_back(_RCPtr<_Tile>(new _Tile(_tileH(i), _tileW(j), value)));
+			_dirty.assign(_tiles.size(), false);
+		}
+
+		//ӳܵArray2D
+		template<class _Al>
+		TiledArray2D(const Array2D<_Elem, _Al> &src, size_t tileSize = 64)
+			:_h(src.h()), _w(src.w()), _ts(tileSize)
+		{
+			if (tileSize == 0)
+				ARRARY_DEBUG_ERROR("dimension can not be zero!");
+			_th = (_h + _ts - 1) / _ts;
+			_tw = (_w + _ts - 1) / _ts;
+			_tiles.reserve(_th * _tw);
+			const _Elem *p = src.data();
+			for (size_t i = 0; i != _th; i++)
+				for (size_t j = 0; j != _tw; j++)
+				{
+					size_t th = _tileH(i), tw = _tileW(j);
+					_Tile *t = new _Tile(th, tw, _Elem());
+					_tiles.push_back(_RCPtr<_Tile>(t));
+					for (size_t r = 0; r != th; r++)
+					{
+						const _Elem *row = p + (i * _ts + r) * _w + j * _ts;
+						std::copy(row, row + tw, t->_data.begin() + r * tw);
+					}
+				}
+			_dirty.assign(_tiles.size(), false);
+		}
+
+		size_t h() const { return _h; }
+
+		size_t w() const { return _w; }
+
+		size_t tileSize() const { return _ts; }
+
+		size_t tileRows() const { return _th; }
+
+		size_t tileCols() const { return _tw; }
+
+		const _Elem &at(size_t row, size_t col) const
+		{
+			if (row >= _h || col >= _w)
+				ARRARY_DEBUG_ERROR("index out of range!");
+			const _Tile &t = *_tiles[(row / _ts) * _tw + col / _ts].get();
+			return t._data[(row % _ts) * t._w + col % _ts];
+		}
+
+		//д뵥ԪأֻڵĿ
+		void set(size_t row, size_t col, const _Elem &value)
+		{
+			if (row >= _h || col >= _w)
+				ARRARY_DEBUG_ERROR("index out of range!");
+			_Elem *p = writeTile(row / _ts, col / _ts);
+			p[(row % _ts) * _tileW(col / _ts) + col % _ts] = value;
+		}
+
+		//(tr, tc)ֻݣ򣬿Ϊÿʵʿ
+		const _Elem *tile(size_t tr, size_t tc) const
+		{
+			if (tr >= _th || tc >= _tw)
+				ARRARY_DEBUG_ERROR("tile out of range!");
+			return _tiles[tr * _tw + tc].get()->_data.data();
+		}
+
+		//(tr, tc)ĿдݣʱȸƸÿ鲢Ϊ
+		//صָڱһα֮ǰЧ
+		_Elem *writeTile(size_t tr, size_t tc)
+		{
+			if (tr >= _th || tc >= _tw)
+				ARRARY_DEBUG_ERROR("tile out of range!");
+			size_t idx = tr * _tw + tc;
+			_dirty[idx] = true;
+			return _tiles[idx]->_data.data();
+		}
+
+		bool isDirty(size_t tr, size_t tc) const
+		{
+			if (tr >= _th || tc >= _tw)
+				ARRARY_DEBUG_ERROR("tile out of range!");
+			return _dirty[tr * _tw + tc];
+		}
+
+		//λͼ
+		const std::vector<bool> &dirtyMap() const
+		{
+			return _dirty;
+		}
+
+		//(tr, tc)
+		std::vector<pair<size_t, size_t> > dirtyTiles() const
+		{
+			std::vector<pair<size_t, size_t> > result;
+			for (size_t i = 0; i != _dirty.size(); i++)
+				if (_dirty[i])
+					result.push_back(pair<size_t, size_t>(i / _tw, i % _tw));
+			return result;
+		}
+
+		void clearDirty()
+		{
+			_dirty.assign(_dirty.size(), false);
+		}
+
+		//(tr, tc)Ƿ
+		bool isTileShared(size_t tr, size_t tc) const
+		{
+			return _tiles[tr * _tw + tc].get()->isShared();
+		}
+
+		//дسܵArray2Ddstάȱһ
+		template<class _Al>
+		void copyTo(Array2D<_Elem, _Al> &dst) const
+		{
+			if (dst.h() != _h || dst.w() != _w)
+				ARRARY_DEBUG_ERROR("the object dimension isn't same as the the object assigned");
+			_Elem *p = dst._writableData();
+			for (size_t i = 0; i != _th; i++)
+				for (size_t j = 0; j != _tw; j++)
+				{
+					const _Tile &t = *_tiles[i * _tw + j].get();
+					size_t th = _tileH(i), tw = t._w;
+					for (size_t r = 0; r != th; r++)
+						std::copy(t._data.begin() + r * tw, t._data.begin() + (r + 1) * tw,
+							p + (i * _ts + r) * _w + j * _ts);
+				}
+		}
+	private:
+		size_t _tileH(size_t tr) const
+		{
+			return std::min(_ts, _h - tr * _ts);
+		}
+
+		size_t _tileW(size_t tc) const
+		{
+			return std::min(_ts, _w - tc * _ts);
+		}
+
+		size_t _h, _w, _ts, _th, _tw;
+		std::vector<_RCPtr<_Tile> > _tiles;
+		std::vector<bool> _dirty;
+	};
+}
+
+#endif // !ARRARY_TILED
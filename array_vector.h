@@ -0,0 +1,266 @@
+/* Array2D֮ķôܼ
+ * gemvy = A * xgevmy = x^T * ArowDotsе
+ * broadcastRows/broadcastColumnsлй㲥a(i, j) = op(a(i, j), v[ji])
+ * ÿֻ˳ɨһĻforEachRowBlockп鲢
+ * _DotLanes·ۼӣԲıذǷŽĴ
+ * Ĺ㲥ѡʱд(_StreamingStore)棬ҲʡдĶ
+*/
+
+#ifndef ARRARY_VECTOR
+#define ARRARY_VECTOR
+
+#include "array.h"
+#include <vector>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ARRARY_HAS_STREAM_STORE
+#endif
+
+namespace arr
+{
+	enum StoreHint
+	{
+		_CachedStore,		//ͨд
+		_StreamingStore		//ʱдƹ棬ֻԿ԰ֽڸƵԪЧ
+	};
+
+	const size_t _DotLanes = 8;
+
+	template<class _Elem>
+	inline _Elem _dot(const _Elem *ARRARY_RESTRICT a, const _Elem *ARRARY_RESTRICT b, size_t n)
+	{
+		_Elem acc[_DotLanes] = {};
+		size_t j = 0;
+		for (; j + _DotLanes <= n; j += _DotLanes)
+			for (size_t k = 0; k != _DotLanes; k++)
+				acc[k] += a[j + k] * b[j + k];
+		for (size_t k = 0; j != n; j++, k++)
+			acc[k] += a[j] * b[j];
+		for (size_t s = _DotLanes / 2; s; s /= 2)
+			for (size_t k = 0; k != s; k++)
+				acc[k] += acc[k + s];
+		return acc[0];
+	}
+
+	//y += alpha * x
+	template<class _Elem>
+	inline void _axpy(_Elem alpha, const _Elem *ARRARY_RESTRICT x, _Elem *ARRARY_RESTRICT y, size_t n)
+	{
+		for (size_t j = 0; j != n; j++)
+			y[j] += alpha * x[j];
+	}
+
+	//[src, src + bytes)дdst16ֽڶĲ÷ʱдβmemcpy
+	inline void _streamCopy(void *dst, const void *src, size_t bytes)
+	{
+#ifdef ARRARY_HAS_STREAM_STORE
+		char *d = static_cast<char *>(dst);
+		const char *s = static_cast<const char *>(src);
+		size_t head = (16 - reinterpret_cast<size_t>(d) % 16) % 16;
+		if (head > bytes)
+			head = bytes;
+		std::memcpy(d, s, head);
+		d += head;
+		s += head;
+		bytes -= head;
+		for (; bytes >= 16; d += 16, s += 16, bytes -= 16)
+			_mm_stream_si128(reinterpret_cast<__m128i *>(d),
+				_mm_loadu_si128(reinterpret_cast<const __m128i *>(s)));
+		std::memcpy(d, s, bytes);
+#else
+		std::memcpy(dst, src, bytes);
+#endif
+	}
+
+	//ʱдģ߳̽ǰҪ֤߳̿ɼ
+	inline void _streamFence()
+	{
+#ifdef ARRARY_HAS_STREAM_STORE
+		_mm_sfence();
+#endif
+	}
+
+	//y = A * xx.size() == w()
+	template<class _Elem, class _Alloc>
+	std::vector<_Elem> gemv(const Array2D<_Elem, _Alloc> &a, const std::vector<_Elem> &x)
+	{
+		size_t h = a.h(), w = a.w();
+		if (x.size() != w)
+			ARRARY_DEBUG_ERROR("the vector size isn't same as the columns");
+		std::vector<_Elem> y(h);
+		const _Elem *pa = a.data(), *px = &x[0];
+		_Elem *py = &y[0];
+		forEachRowBlock(h, w, [=](size_t first, size_t last, size_t)
+		{
+			for (size_t i = first; i != last; i++)
+				py[i] = _dot(pa + i * w, px, w);
+		});
+		return y;
+	}
+
+	//y = x^T * Ax.size() == h()
+	//ÿпx(i) * iۼӵԼĲֺвкϲ
+	template<class _Elem, class _Alloc>
+	std::vector<_Elem> gevm(const std::vector<_Elem> &x, const Array2D<_Elem, _Alloc> &a)
+	{
+		size_t h = a.h(), w = a.w();
+		if (x.size() != h)
+			ARRARY_DEBUG_ERROR("the vector size isn't same as the rows");
+		size_t parts = std::thread::hardware_concurrency() + 1;
+		std::vector<_Elem> partial(parts * w), y(w);
+		const _Elem *pa = a.data(), *px = &x[0];
+		_Elem *pp = &partial[0], *py = &y[0];
+		forEachRowBlock(h, w, [=](size_t first, size_t last, size_t block)
+		{
+			_Elem *sum = pp + block * w;
+			for (size_t i = first; i != last; i++)
+				_axpy(px[i], pa + i * w, sum, w);
+		});
+		forEachRowBlock(w, parts, [=](size_t first, size_t last, size_t)
+		{
+			for (size_t b = 0; b != parts; b++)
+			{
+				const _Elem *ARRARY_RESTRICT sum = pp + b * w;
+				_Elem *ARRARY_RESTRICT out = py;
+				for (size_t j = first; j != last; j++)
+					out[j] += sum[j];
+			}
+		});
+		return y;
+	}
+
+	//out[i] = aĵiкbĵiеĵabάȱһ
+	template<class _Elem, class _Alloc>
+	std::vector<_Elem> rowDots(const Array2D<_Elem, _Alloc> &a, const Array2D<_Elem, _Alloc> &b)
+	{
+		size_t h = a.h(), w = a.w();
+		if (b.h() != h || b.w() != w)
+			ARRARY_DEBUG_ERROR("the object dimension isn't same as the object multiplied");
+		std::vector<_Elem> out(h);
+		const _Elem *pa = a.data(), *pb = b.data();
+		_Elem *po = &out[0];
+		forEachRowBlock(h, w, [=](size_t first, size_t last, size_t)
+		{
+			for (size_t i = first; i != last; i++)
+				po[i] = _dot(pa + i * w, pb + i * w, w);
+		});
+		return out;
+	}
+
+	//a(i, j) = op(a(i, j), v[j])v.size() == w()
+	template<class _Elem, class _Alloc, class _Op>
+	void broadcastRowsInPlace(Array2D<_Elem, _Alloc> &a, const std::vector<_Elem> &v, _Op op)
+	{
+		size_t h = a.h(), w = a.w();
+		if (v.size() != w)
+			ARRARY_DEBUG_ERROR("the vector size isn't same as the columns");
+		_Elem *pa = a._writableData();
+		const _Elem *pv = &v[0];
+		forEachRowBlock(h, w, [=](size_t first, size_t last, size_t)
+		{
+			for (size_t i = first; i != last; i++)
+			{
+				_Elem *ARRARY_RESTRICT row = pa + i * w;
+				const _Elem *ARRARY_RESTRICT in = pv;
+				for (size_t j = 0; j != w; j++)
+					row[j] = op(row[j], in[j]);
+			}
+		});
+	}
+
+	//a(i, j) = op(a(i, j), v[i])v.size() == h()
+	template<class _Elem, class _Alloc, class _Op>
+	void broadcastColumnsInPlace(Array2D<_Elem, _Alloc> &a, const std::vector<_Elem> &v, _Op op)
+	{
+		size_t h = a.h(), w = a.w();
+		if (v.size() != h)
+			ARRARY_DEBUG_ERROR("the vector size isn't same as the rows");
+		_Elem *pa = a._writableData();
+		const _Elem *pv = &v[0];
+		forEachRowBlock(h, w, [=](size_t first, size_t last, size_t)
+		{
+			for (size_t i = first; i != last; i++)
+			{
+				_Elem *ARRARY_RESTRICT row = pa + i * w;
+				_Elem s = pv[i];
+				for (size_t j = 0; j != w; j++)
+					row[j] = op(row[j], s);
+			}
+		});
+	}
+
+	//Ĺ㲥f(i, j, n, in, out)ѵi[j, j + n)Ľдout
+	//ʱдʱһС黺ãƹдȥĿ겻Ҫȳʼ
+	template<class _Elem, class _Alloc, class _Fn>
+	Array2D<_Elem, _Alloc> _broadcastTo(const Array2D<_Elem, _Alloc> &a, StoreHint hint, _Fn f)
+	{
+		size_t h = a.h(), w = a.w();
+		const _Elem *ps = a.data();
+		//ֽܰڸƵԪظɷʱдķ֧
+		if constexpr (is_trivially_copyable<_Elem>::value)
+		{
+			if (hint == _StreamingStore)
+			{
+				const size_t _Chunk = sizeof(_Elem) >= 4096 ? 1 : 4096 / sizeof(_Elem);
+				Array2D<_Elem, _Alloc> dst(h, w);
+				_Elem *pd = dst._writableData();
+				forEachRowBlock(h, w, [=](size_t first, size_t last, size_t)
+				{
+					_Elem buf[_Chunk];
+					for (size_t i = first; i != last; i++)
+						for (size_t j = 0; j < w; j += _Chunk)
+						{
+							size_t n = std::min(_Chunk, w - j);
+							f(i, j, n, ps + i * w + j, buf);
+							_streamCopy(pd + i * w + j, buf, n * sizeof(_Elem));
+						}
+					_streamFence();
+				});
+				return dst;
+			}
+		}
+		Array2D<_Elem, _Alloc> dst(h, w, first_touch, _Elem());
+		_Elem *pd = dst._writableData();
+		forEachRowBlock(h, w, [=](size_t first, size_t last, size_t)
+		{
+			for (size_t i = first; i != last; i++)
+				f(i, 0, w, ps + i * w, pd + i * w);
+		});
+		return dst;
+	}
+
+	//op(a(i, j), v[j])ɵ
+	template<class _Elem, class _Alloc, class _Op>
+	Array2D<_Elem, _Alloc> broadcastRows(const Array2D<_Elem, _Alloc> &a, const std::vector<_Elem> &v,
+		_Op op, StoreHint hint = _CachedStore)
+	{
+		if (v.size() != a.w())
+			ARRARY_DEBUG_ERROR("the vector size isn't same as the columns");
+		const _Elem *pv = &v[0];
+		return _broadcastTo(a, hint, [=](size_t, size_t j, size_t n,
+			const _Elem *ARRARY_RESTRICT in, _Elem *ARRARY_RESTRICT out)
+		{
+			for (size_t k = 0; k != n; k++)
+				out[k] = op(in[k], pv[j + k]);
+		});
+	}
+
+	//op(a(i, j), v[i])ɵ
+	template<class _Elem, class _Alloc, class _Op>
+	Array2D<_Elem, _Alloc> broadcastColumns(const Array2D<_Elem, _Alloc> &a, const std::vector<_Elem> &v,
+		_Op op, StoreHint hint = _CachedStore)
+	{
+		if (v.size() != a.h())
+			ARRARY_DEBUG_ERROR("the vector size isn't same as the rows");
+		const _Elem *pv = &v[0];
+		return _broadcastTo(a, hint, [=](size_t i, size_t, size_t n,
+			const _Elem *ARRARY_RESTRICT in, _Elem *ARRARY_RESTRICT out)
+		{
+			_Elem s = pv[i];
+			for (size_t k = 0; k != n; k++)
+				out[k] = op(in[k], s);
+		});
+	}
+}
+
+#endif // !ARRARY_VECTOR
@@ -0,0 +1,201 @@
+#include "array.h"
+#include "test_util.h"
+#include <atomic>
+#include <complex>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace arr;
+
+struct Counted
+{
+	static std::atomic<int> live;
+	int v;
+	Counted(int x) :v(x) { if (x == 777777) throw std::runtime_error("bomb"); ++live; }
+	Counted(const Counted &rhs) :v(rhs.v) { ++live; }
+	Counted &operator=(const Counted &rhs) { v = rhs.v; return *this; }
+	~Counted() { --live; }
+};
+std::atomic<int> Counted::live(0);
+
+std::ostream &operator<<(std::ostream &os, const Counted &c)
+{
+	return os << c.v;
+}
+
+struct Point
+{
+	int x, y;
+	bool operator==(const Point &rhs) const { return x == rhs.x && y == rhs.y; }
+};
+
+//Զʽ
+class Labelled :public SquareMartrix<int>
+{
+public:
+	explicit Labelled(size_t n) :SquareMartrix<int>(n, 1) { }
+
+	void print(std::ostream &os = std::cout, char = ' ', char = '\n') const
+	{
+		os << "matrix " << w();
+	}
+};
+
+static void testPrint()
+{
+	std::ostringstream a, b, c;
+	a << SquareMartrix<int>(2, 1);
+	ARR_CHECK(a.str() == "1 1 \n1 1 \n");
+	bool bits[2] = { true, false };
+	b << Array2D<bool>(1, 2, bits, bits + 2);
+	ARR_CHECK(b.str() == "1 0 \n");
+	Labelled l(3);
+	c << l;
+	ARR_CHECK(c.str() == "matrix 3");
+}
+
+static void testCopyOnWrite()
+{
+	Array2D<int> a(3, 4, 1), b(a);
+	ARR_CHECK(a.isShared() && b.isShared());
+	b[1][2] = 5;
+	ARR_CHECK(a[1][2] == 1 && b[1][2] == 5 && !(a == b));
+
+	Array2D<int> c(2, 2, 0);
+	c = a;
+	ARR_CHECK(c == a && c.h() == 3 && c.w() == 4);
+	c = c;
+	ARR_CHECK(c == a);
+
+	bool bits[6] = { true, false, true, false, true, true };
+	Array2D<bool> p(2, 3, bits, bits + 6), q(1, 1, bits, bits + 1);
+	q = p;
+	ARR_CHECK(q == p && q.h() == 2 && q[1][2]);
+
+	SquareMartrix<int> m(3, 2), n(3, 0);
+	n = m;
+	ARR_CHECK(n == m && n[2][2] == 2);
+}
+
+static void testHash()
+{
+	Array2D<double> a(50, 50, 1.5), b(50, 50, 1.5), c(50, 50, 2.0), z(2, 2, 0.0), nz(2, 2, -0.0);
+	ARR_CHECK(a.hash() == b.hash() && a.hash() != c.hash() && z.hash() == nz.hash());
+	Array2D<double> d(a);
+	size_t h = a.hash();
+	d[0][0] = 3.0;
+	ARR_CHECK(d.hash() != h && a.hash() == h);
+
+	//ûstd::hashԪԱȽ
+	Array2D<std::complex<double>> p(3, 3, std::complex<double>(1, 2)), q(p);
+	ARR_CHECK(p == q);
+	q[2][2] = 0;
+	ARR_CHECK(p != q);
+	SquareMartrix<Point> s(4, Point{ 1, 2 }), t(4, Point{ 1, 2 }), u(4, Point{ 2, 1 });
+	ARR_CHECK(s == t && !(s == u));
+}
+
+static void testConstruction()
+{
+	Array2D<long> g(1000, 999, from_generator, [](size_t r, size_t c) { return long(r * 1000 + c); });
+	ARR_CHECK(g.isFirstTouch());
+	for (size_t r = 0; r < 1000; r += 7)
+		for (size_t c = 0; c < 999; c += 13)
+			ARR_CHECK(g.at(r, c) == long(r * 1000 + c));
+
+	SquareMartrix<double> t(1000, first_touch, 2);
+	ARR_CHECK(t.isFirstTouch() && t[999][999] == 2.0);
+	SquareMartrix<double> u(t);
+	u[0][0] = 1;
+	ARR_CHECK(t[0][0] == 2.0 && u.isFirstTouch());
+
+	bool thrown = false;
+	try
+	{
+		Array2D<Counted> bomb(1000, 1000, from_generator, [](size_t r, size_t c) { return Counted(int(r * 1000 + c)); });
+	}
+	catch (std::runtime_error &)
+	{
+		thrown = true;
+	}
+	ARR_CHECK(thrown && Counted::live == 0);
+}
+
+static void testRowsAndColumns()
+{
+	Array2D<int> a(5, 3, 0);
+	std::iota(a.begin(), a.end(), 0);
+	auto c = a.col(2);
+	ARR_CHECK(c.size() == 5 && c.end() - c.begin() == 5 && *(c.end() - 1) == 14 && c[1] == 5);
+	std::sort(a.col(1).begin(), a.col(1).end(), std::greater<int>());
+	ARR_CHECK(a[0][1] == 13 && a[4][1] == 1);
+	const Array2D<int> &ca = a;
+	ARR_CHECK(std::accumulate(ca.row(1).begin(), ca.row(1).end(), 0) == 3 + 10 + 5);
+	ARR_CHECK(std::equal(ca.begin(), ca.end(), ca.data()));
+}
+
+static void testTranspose()
+{
+	for (size_t n : { 1, 3, 33, 300 })
+	{
+		SquareMartrix<int> m(n, 0);
+		std::iota(m.begin(), m.end(), 0);
+		SquareMartrix<int> k(m);
+		m.change();
+		for (size_t i = 0; i != n; i++)
+			for (size_t j = 0; j != n; j++)
+				ARR_CHECK(m[i][j] == int(j * n + i) && k[i][j] == int(i * n + j));
+	}
+}
+
+static void testRowBlocks()
+{
+	std::atomic<size_t> rows(0);
+	forEachRowBlock(1000, 1000, [&](size_t first, size_t last, size_t) { rows += last - first; });
+	ARR_CHECK(rows == 1000);
+	bool thrown = false;
+	try
+	{
+		forEachRowBlock(1000, 1000, [](size_t first, size_t, size_t)
+		{
+			if (first == 0)
+				throw std::runtime_error("block");
+		});
+	}
+	catch (std::runtime_error &)
+	{
+		thrown = true;
+	}
+	ARR_CHECK(thrown);
+}
+
+static void testExternalBuffer()
+{
+	static int buf[6] = { 1, 2, 3, 4, 5, 6 };
+	bool released = false;
+	{
+		std::function<void()> release = [&released]() { released = true; };
+		Array2D<int> a(2, 3, external_buffer, buf, release);
+		const Array2D<int> &ca = a;
+		ARR_CHECK(a.isReadOnly() && !a.isShared() && ca.data() == buf && ca[1][2] == 6);
+		Array2D<int> b(a);
+		b[0][0] = 9;
+		ARR_CHECK(!b.isReadOnly() && b[0][0] == 9 && buf[0] == 1 && a.isReadOnly());
+	}
+	ARR_CHECK(released);
+}
+
+int main()
+{
+	testCopyOnWrite();
+	testHash();
+	testConstruction();
+	testRowsAndColumns();
+	testTranspose();
+	testRowBlocks();
+	testExternalBuffer();
+	testPrint();
+	return 0;
+}
@@ -0,0 +1,42 @@
+#include "array_batch.h"
+#include "test_util.h"
+#include <cmath>
+#include <vector>
+
+using namespace arr;
+
+int main()
+{
+	std::vector<SquareMartrix<double> > v;
+	for (int k = 0; k != 5; k++)
+	{
+		std::vector<double> d(16);
+		for (int i = 0; i != 16; i++)
+			d[i] = (i * 7 + k * 3) % 11 + (i % 5 == 0 ? 10 : 0);
+		v.emplace_back(4, d.begin(), d.end());
+	}
+	SquareBatch<double> b(v.begin(), v.end());
+	ARR_CHECK(b.order() == 4 && b.count() == 5 && b.get(3) == v[3]);
+
+	SquareBatch<double> inv(4, 5);
+	std::vector<char> singular;
+	size_t ns = b.inverse(inv, &singular);
+	SquareBatch<double> p = b.multiply(inv);
+	for (size_t k = 0; k != 5; k++)
+	{
+		if (singular[k])
+			continue;
+		for (size_t i = 0; i != 4; i++)
+			for (size_t j = 0; j != 4; j++)
+				ARR_CHECK(std::abs(p.at(k, i, j) - (i == j ? 1.0 : 0.0)) < 1e-9);
+	}
+	ARR_CHECK(ns == size_t(std::count(singular.begin(), singular.end(), 1)));
+
+	SquareBatch<double> c(b);
+	c.change();
+	for (size_t k = 0; k != 5; k++)
+		for (size_t i = 0; i != 4; i++)
+			for (size_t j = 0; j != 4; j++)
+				ARR_CHECK(c.at(k, i, j) == b.at(k, j, i));
+	return 0;
+}
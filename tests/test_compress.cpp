@@ -0,0 +1,71 @@
+#include "array_compress.h"
+#include "test_util.h"
+#include <climits>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace arr;
+
+template<class _Ty>
+static void roundTrip(const std::vector<_Ty> &d, size_t n)
+{
+	SquareMartrix<_Ty> m(n, d.begin(), d.end());
+	CompressedArray2D<_Ty> c(m, 1000, 3);
+	const SquareMartrix<_Ty> &cm = m;
+	for (size_t i = 0; i != n; i++)
+		for (size_t j = 0; j != n; j++)
+			ARR_CHECK(c.at(i, j) == cm[i][j]);
+	SquareMartrix<_Ty> o(n);
+	c.decompress(o);
+	ARR_CHECK(std::equal(d.begin(), d.end(), static_cast<const SquareMartrix<_Ty> &>(o).data()));
+	ARR_CHECK(c.decompressCount() > 0);
+}
+
+int main()
+{
+	size_t n = 200;
+	std::vector<int> a(n * n);
+	std::vector<long long> b(n * n);
+	std::vector<double> f(n * n);
+	std::vector<float> g(n * n);
+	std::vector<unsigned char> u(n * n);
+	for (size_t i = 0; i != n * n; i++)
+	{
+		a[i] = int(i % 77) - 30;
+		b[i] = (long long)i * 1000000007LL * (i % 2 ? -1 : 1);
+		f[i] = 1.0 + (i % 10) * 0.5;
+		g[i] = std::sin(i * 0.01f);
+		u[i] = i % 5;
+	}
+	b[5] = LLONG_MIN;
+	b[6] = LLONG_MAX;
+	roundTrip(a, n);
+	roundTrip(b, n);
+	roundTrip(f, n);
+	roundTrip(g, n);
+	roundTrip(u, n);
+
+	SquareMartrix<int> m(n, a.begin(), a.end());
+	CompressedArray2D<int> c(m, 512, 2);
+	ARR_CHECK(c.compressionRatio() > 1.0);
+	std::vector<std::thread> readers;
+	bool wrong[4] = {};
+	for (int t = 0; t != 4; t++)
+		readers.emplace_back([&, t]
+		{
+			for (size_t k = 0; k != 20000; k++)
+			{
+				size_t i = (k * 37 + t * 101) % n, j = (k * 13) % n;
+				if (c.at(i, j) != a[i * n + j])
+					wrong[t] = true;
+			}
+		});
+	for (size_t t = 0; t != readers.size(); t++)
+		readers[t].join();
+	ARR_CHECK(!wrong[0] && !wrong[1] && !wrong[2] && !wrong[3]);
+
+	CompressedArray2D<int> copy(c);
+	ARR_CHECK(copy.decompressCount() == 0 && copy.at(5, 5) == a[5 * n + 5]);
+	return 0;
+}
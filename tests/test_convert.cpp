@@ -0,0 +1,89 @@
+#include "array_convert.h"
+#include "test_util.h"
+#include <cmath>
+#include <limits>
+
+using namespace arr;
+
+static void testHalf()
+{
+	for (unsigned b = 0; b != 65536; b++)
+	{
+		float f = Half::fromBits(static_cast<unsigned short>(b));
+		float g = BFloat16::fromBits(static_cast<unsigned short>(b));
+		ARR_CHECK(std::isnan(f) ? std::isnan(float(Half(f))) : Half(f).bits() == b);
+		ARR_CHECK(std::isnan(g) ? std::isnan(float(BFloat16(g))) : BFloat16(g).bits() == b);
+	}
+	ARR_CHECK(float(Half(65504.f)) == 65504.f && std::isinf(float(Half(70000.f))));
+	ARR_CHECK(BFloat16(1.00390625f).bits() == 0x3f80);
+	//float16λеϣֻһ
+	ARR_CHECK(saturateCast<Half>(1 + std::ldexp(1.0, -11) + std::ldexp(1.0, -40)).bits() == 0x3c01);
+	ARR_CHECK(saturateCast<Half>(-1 - std::ldexp(1.0, -11) - std::ldexp(1.0, -40)).bits() == 0xbc01);
+	ARR_CHECK(saturateCast<Half>(1 + std::ldexp(1.0, -11)).bits() == 0x3c00);
+	ARR_CHECK(saturateCast<BFloat16>(1 + std::ldexp(1.0, -8) + std::ldexp(1.0, -40)).bits() == 0x3f81);
+	ARR_CHECK(saturateCast<BFloat16>(16842753).bits() == 0x4b81);
+	ARR_CHECK(saturateCast<Half>(1e300).bits() == 0x7c00 && saturateCast<Half>(1e-300).bits() == 0x0000);
+	ARR_CHECK(saturateCast<BFloat16>(std::ldexp(1.0, -132) + std::ldexp(1.0, -134) + std::ldexp(1.0, -160)).bits() == 0x0003);
+	ARR_CHECK(std::isnan(float(saturateCast<Half>(std::nan("")))));
+	Array2D<double> d(2, 2, 1 + std::ldexp(1.0, -11) + std::ldexp(1.0, -40));
+	ARR_CHECK(convert<Half>(d).data()[3].bits() == 0x3c01);
+}
+
+static void testSaturate()
+{
+	typedef std::numeric_limits<int> I;
+	ARR_CHECK(saturateCast<signed char>(300) == 127 && saturateCast<signed char>(-300) == -128);
+	ARR_CHECK(saturateCast<unsigned char>(-5) == 0 && saturateCast<unsigned char>(300u) == 255);
+	ARR_CHECK(saturateCast<unsigned>(-1) == 0u && saturateCast<int>(4000000000u) == I::max());
+	ARR_CHECK(saturateCast<int>(2.5) == 2 && saturateCast<int>(-2.5) == -2 && saturateCast<int>(3.5) == 4);
+	ARR_CHECK(saturateCast<int>(1e20) == I::max() && saturateCast<int>(-1e20) == I::min());
+	ARR_CHECK(saturateCast<int>(3e9f) == I::max() && saturateCast<int>(2147483520.0f) == 2147483520);
+	ARR_CHECK(saturateCast<int>(std::numeric_limits<float>::quiet_NaN()) == 0);
+	ARR_CHECK(saturateCast<long long>(1e30f) == std::numeric_limits<long long>::max());
+	//Ƚضپȷ룬Ϊ0.5λ
+	ARR_CHECK(saturateCast<int>(8388609.0f) == 8388609);
+	ARR_CHECK(saturateCast<int>(0.49999997f) == 0);
+	ARR_CHECK(saturateCast<long long>(4503599627370497.0) == 4503599627370497LL);
+}
+
+static void testConvert()
+{
+	Array2D<double> a(300, 257, from_generator, [](size_t i, size_t j) { return std::sin(double(i * 257 + j)) * (1.0 + double(i)); });
+	const Array2D<double> &ca = a;
+	Array2D<float> f = convert<float>(a);
+	Array2D<signed char> i8 = convert<signed char>(a);
+	Array2D<int> i32 = convert<int>(f);
+	Array2D<BFloat16> bf = convert<BFloat16>(f);
+	const Array2D<float> &cf = f;
+	for (size_t i = 0; i != a.h(); i++)
+		for (size_t j = 0; j != a.w(); j++)
+		{
+			ARR_CHECK(cf[i][j] == float(ca[i][j]));
+			ARR_CHECK(i8[i][j] == saturateCast<signed char>(ca[i][j]));
+			ARR_CHECK(i32[i][j] == int(std::nearbyint(cf[i][j])));
+			ARR_CHECK(std::abs(float(bf[i][j]) - cf[i][j]) <= std::abs(cf[i][j]) / 128);
+		}
+
+	QuantGranularity grans[] = { _PerTensor, _PerRow };
+	for (size_t k = 0; k != 2; k++)
+	{
+		QuantizedArray2D<signed char> q(a, grans[k]);
+		Array2D<float> dq = q.dequantize<float>();
+		for (size_t i = 0; i != a.h(); i++)
+			for (size_t j = 0; j != a.w(); j++)
+				ARR_CHECK(std::abs(dq[i][j] - ca[i][j]) <= q.params(i).scale * 0.51 + 1e-4 && dq[i][j] == q.at(i, j));
+		if (grans[k] == _PerRow)
+			ARR_CHECK(q.params(0).scale < q.params(299).scale);
+	}
+	QuantParams p = { 0.5f, 3 };
+	QuantizedArray2D<signed char> qf(a, p);
+	ARR_CHECK(qf.values()[299][0] == saturateCast<signed char>(ca[299][0] / 0.5 + 3));
+}
+
+int main()
+{
+	testHalf();
+	testSaturate();
+	testConvert();
+	return 0;
+}
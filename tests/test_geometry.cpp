@@ -0,0 +1,49 @@
+#include "array_geometry.h"
+#include "test_util.h"
+#include <string>
+
+using namespace arr;
+
+template<class _Ty, class _Fn>
+static void check(size_t h, size_t w, _Fn value)
+{
+	Array2D<_Ty> a(h, w, from_generator, value);
+	const Array2D<_Ty> &c = a;
+	Array2D<_Ty> r = rotate90(c), l = rotate270(c), t = rotate180(c), fh = flipHorizontal(c), fv = flipVertical(c);
+	ARR_CHECK(r.h() == w && r.w() == h && l.h() == w && l.w() == h);
+	const Array2D<_Ty> &cr = r, &cl = l, &ct = t, &cfh = fh, &cfv = fv;
+	for (size_t i = 0; i != h; i++)
+		for (size_t j = 0; j != w; j++)
+		{
+			ARR_CHECK(cr[j][h - 1 - i] == c[i][j]);
+			ARR_CHECK(cl[w - 1 - j][i] == c[i][j]);
+			ARR_CHECK(ct[h - 1 - i][w - 1 - j] == c[i][j]);
+			ARR_CHECK(cfh[i][w - 1 - j] == c[i][j]);
+			ARR_CHECK(cfv[h - 1 - i][j] == c[i][j]);
+		}
+	Array2D<_Ty> x(c), y(c), z(c);
+	flipHorizontalInPlace(x);
+	flipVerticalInPlace(y);
+	rotate180InPlace(z);
+	ARR_CHECK(x == fh && y == fv && z == t);
+	if (h == w)
+	{
+		Array2D<_Ty> q(c), q2(c);
+		rotate90InPlace(q);
+		rotate270InPlace(q2);
+		ARR_CHECK(q == r && q2 == l);
+	}
+}
+
+int main()
+{
+	size_t shapes[][2] = { { 1, 1 }, { 3, 5 }, { 70, 33 }, { 100, 100 }, { 257, 257 }, { 600, 600 } };
+	for (size_t k = 0; k != sizeof(shapes) / sizeof(shapes[0]); k++)
+		check<int>(shapes[k][0], shapes[k][1], [](size_t i, size_t j) { return int(i * 1000 + j); });
+	for (size_t k = 0; k != 4; k++)
+		check<std::string>(shapes[k][0], shapes[k][1], [](size_t i, size_t j)
+		{
+			return std::to_string(i) + "," + std::to_string(j) + " is long enough to skip the small buffer";
+		});
+	return 0;
+}
@@ -0,0 +1,27 @@
+#include "array_hugepage.h"
+#include "test_util.h"
+
+using namespace arr;
+
+int main()
+{
+	typedef HugePageAllocator<double> A;
+	SquareMartrix<double, A> big(1024, 1.0), small(10, 2.0);
+	const SquareMartrix<double, A> &cb = big, &cs = small;
+	ARR_CHECK(A::hugePageKind(cs.data()) == _NormalPages);
+#if defined(__linux__)
+	ARR_CHECK(reinterpret_cast<size_t>(cb.data()) % (size_t(2) << 20) == 0);
+#endif
+	SquareMartrix<double, A> c(big);
+	c[3][3] = 5;
+	ARR_CHECK(cb[3][3] == 1.0 && c[3][3] == 5.0 && c[1023][1023] == 1.0);
+
+	size_t old = A::threshold();
+	A::setThreshold(1);
+	{
+		SquareMartrix<double, A> tiny(2, 3.0);
+		ARR_CHECK(tiny[1][1] == 3.0);
+	}
+	A::setThreshold(old);
+	return 0;
+}
@@ -0,0 +1,58 @@
+#include "array_integral.h"
+#include "test_util.h"
+#include <cmath>
+#include <random>
+
+using namespace arr;
+
+template<class _Ty>
+static void check(const Array2D<_Ty> &a, const SummedAreaTable<_Ty> &s, std::mt19937 &g)
+{
+	std::uniform_int_distribution<size_t> rh(0, a.h()), rw(0, a.w());
+	for (int t = 0; t != 200; t++)
+	{
+		size_t r0 = rh(g), r1 = rh(g), c0 = rw(g), c1 = rw(g);
+		if (r0 > r1)
+			std::swap(r0, r1);
+		if (c0 > c1)
+			std::swap(c0, c1);
+		typename SummedAreaTable<_Ty>::sum_type ref = 0;
+		for (size_t i = r0; i != r1; i++)
+			for (size_t j = c0; j != c1; j++)
+				ref += a[i][j];
+		ARR_CHECK(std::abs(double(ref - s.sum(r0, c0, r1, c1))) < 1e-6);
+	}
+}
+
+int main()
+{
+	std::mt19937 g(1);
+	size_t shapes[][2] = { { 1, 1 }, { 3, 7 }, { 64, 1 }, { 1, 90 }, { 300, 257 } };
+	for (size_t k = 0; k != sizeof(shapes) / sizeof(shapes[0]); k++)
+	{
+		size_t h = shapes[k][0], w = shapes[k][1];
+		Array2D<int> a(h, w, from_generator, [](size_t i, size_t j) { return int((i * 131 + j * 71) % 201) - 100; });
+		SummedAreaTable<int> s(a);
+		check(static_cast<const Array2D<int> &>(a), s, g);
+		for (int round = 0; round != 5; round++)
+		{
+			size_t r = g() % h, c = g() % w;
+			size_t r1 = std::min(h, r + 1 + g() % 5), c1 = std::min(w, c + 1 + g() % 5);
+			for (size_t i = r; i != r1; i++)
+				for (size_t j = c; j != c1; j++)
+					a[i][j] = int(g() % 1000);
+			s.markDirty(r, c, r1, c1);
+			ARR_CHECK(s.isDirty());
+			s.update(a);
+			ARR_CHECK(!s.isDirty());
+			check(static_cast<const Array2D<int> &>(a), s, g);
+			ARR_CHECK(SummedAreaTable<int>(a).table() == s.table());
+		}
+
+		Array2D<float> f(h, w, from_generator, [](size_t i, size_t j) { return float(i) * 0.5f - float(j) * 0.25f; });
+		SummedAreaTable<float> sf(f);
+		check(static_cast<const Array2D<float> &>(f), sf, g);
+		ARR_CHECK(std::abs(sf.mean(0, 0, h, w) - sf.sum(0, 0, h, w) / double(h * w)) < 1e-9);
+	}
+	return 0;
+}
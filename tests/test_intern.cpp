@@ -0,0 +1,30 @@
+#include "array_intern.h"
+#include "test_util.h"
+#include <vector>
+
+using namespace arr;
+
+int main()
+{
+	typedef SquareMartrix<double> M;
+	M a(50, 1.5), b(50, 1.5), c(50, 2.0);
+	InternPool<M> pool;
+	M a2 = pool.intern(a), b2 = pool.intern(b), c2 = pool.intern(c);
+	ARR_CHECK(pool.size() == 2 && a2 == b2 && a2 != c2 && pool.contains(b));
+	b2[0][0] = 3;
+	ARR_CHECK(b2.hash() != a2.hash() && a2[0][0] == 1.5);
+
+	M d(50, 1.5);
+	size_t h = d.hash();
+	std::vector<double> v(2500, 7);
+	d.input(v.begin(), v.end());
+	ARR_CHECK(d.hash() != h);
+
+	{
+		M t(3, 1.0);
+		pool.intern(t);
+	}
+	ARR_CHECK(pool.size() == 3);
+	ARR_CHECK(pool.purge() == 1 && pool.size() == 2);
+	return 0;
+}
@@ -0,0 +1,88 @@
+#include "array_packed.h"
+#include "test_util.h"
+#include <cmath>
+#include <stdexcept>
+
+using namespace arr;
+
+template<PackedKind _Kind>
+static void check(size_t n)
+{
+	SquareMartrix<double> d(n, from_generator, [](size_t i, size_t j)
+	{
+		if ((_Kind == _PackedLower && j > i) || (_Kind == _PackedUpper && j < i))
+			return 0.0;
+		if (_Kind == _PackedSymmetric)
+			return double((i + 1) * (j + 1) % 7 + (i == j));
+		return double((i * 31 + j * 17) % 11) - 5;
+	});
+	const SquareMartrix<double> &cd = d;
+	PackedMatrix<double, _Kind> p(d);
+	const PackedMatrix<double, _Kind> &cp = p;
+	ARR_CHECK(p.size() == n * (n + 1) / 2 && p.toDense() == d);
+	for (size_t i = 0; i != n; i++)
+		for (size_t j = 0; j != n; j++)
+			ARR_CHECK(cp[i][j] == cd[i][j]);
+
+	Array2D<double> b(n, 5, from_generator, [](size_t i, size_t j) { return double(i) - double(j) * 0.5; });
+	const Array2D<double> &cb = b;
+	Array2D<double> c = p.multiply(b);
+	const Array2D<double> &cc = c;
+	for (size_t i = 0; i != n; i++)
+		for (size_t j = 0; j != 5; j++)
+		{
+			double s = 0;
+			for (size_t k = 0; k != n; k++)
+				s += cd[i][k] * cb[k][j];
+			ARR_CHECK(std::abs(s - cc[i][j]) < 1e-9);
+		}
+
+	typedef typename PackedMatrix<double, _Kind>::transpose_type _Trans;
+	const _Trans t = p.transposed();
+	for (size_t i = 0; i != n; i++)
+		for (size_t j = 0; j != n; j++)
+			ARR_CHECK(t[i][j] == cd[j][i]);
+
+	if constexpr (_Kind != _PackedSymmetric)
+	{
+		const PackedMatrix<double, _Kind> q = p.multiply(p);
+		for (size_t i = 0; i != n; i++)
+			for (size_t j = 0; j != n; j++)
+			{
+				double s = 0;
+				for (size_t k = 0; k != n; k++)
+					s += cd[i][k] * cd[k][j];
+				ARR_CHECK(std::abs(s - q.at(i, j)) < 1e-9);
+			}
+	}
+	else if (n > 2)
+	{
+		p[1][2] = 42;
+		ARR_CHECK(cp[2][1] == 42);
+	}
+}
+
+int main()
+{
+	size_t orders[] = { 1, 2, 7, 33, 300 };
+	for (size_t k = 0; k != 5; k++)
+	{
+		check<_PackedLower>(orders[k]);
+		check<_PackedUpper>(orders[k]);
+		check<_PackedSymmetric>(orders[k]);
+	}
+#ifndef NDEBUG
+	LowerTriangularMatrix<int> l(4, 1);
+	bool thrown = false;
+	try
+	{
+		l[0][3] = 2;
+	}
+	catch (std::out_of_range &)
+	{
+		thrown = true;
+	}
+	ARR_CHECK(thrown);
+#endif
+	return 0;
+}
@@ -0,0 +1,94 @@
+#include "array_shm.h"
+#include "array_intern.h"
+#include "test_util.h"
+#include <string>
+#include <sys/wait.h>
+
+using namespace arr;
+
+static bool exists(const std::string &name)
+{
+	int fd = shm_open(name.c_str(), O_RDONLY, 0);
+	if (fd < 0)
+		return false;
+	close(fd);
+	return true;
+}
+
+int main()
+{
+	std::string name = "/a2d_test_" + std::to_string(getpid());
+	Array2D<int> src(500, 300, from_generator, [](size_t i, size_t j) { return int(i * 300 + j); });
+	const Array2D<int> &csrc = src;
+	{
+		Array2D<int> pub = SharedArray2D<int>::publish(name, src);
+		ARR_CHECK(pub.isReadOnly() && !pub.isShared() && pub == src && pub.hash() == src.hash());
+
+		bool dup = false, type = false;
+		try { SharedArray2D<int>::publish(name, src); }
+		catch (std::system_error &e) { dup = e.code().value() == EEXIST; }
+		try { SharedArray2D<float>::attach(name); }
+		catch (std::runtime_error &) { type = true; }
+		ARR_CHECK(dup && type);
+
+		Array2D<int> a = SharedArray2D<int>::attach(name);
+		const Array2D<int> &ca = a;
+		ARR_CHECK(ca.data() != csrc.data() && ca == src);
+		Array2D<int> b(a);
+		b[3][4] = -1;
+		ARR_CHECK(!b.isReadOnly() && b[3][4] == -1 && ca[3][4] == 3 * 300 + 4 && a.isReadOnly());
+
+		pid_t pid = fork();
+		if (pid == 0)
+		{
+			Array2D<int> c = SharedArray2D<int>::attach(name);
+			c.data()[0] = 77;
+			_exit(c.data()[0] == 77 && static_cast<const Array2D<int> &>(c)[499][299] == 149999 ? 0 : 1);
+		}
+		int status = 0;
+		waitpid(pid, &status, 0);
+		ARR_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0 && ca.data()[0] == 0);
+		ARR_CHECK(exists(name));
+
+		//ֻõĹڴҲܱpurge
+		InternPool<Array2D<int> > pool;
+		{
+			Array2D<int> pooled = SharedArray2D<int>::attach(name);
+			pool.intern(pooled);
+		}
+		ARR_CHECK(pool.size() == 1 && pool.purge() == 1);
+	}
+	ARR_CHECK(!exists(name));
+
+	{
+		Array2D<int> keep = SharedArray2D<int>::publish(name, src, false);
+	}
+	ARR_CHECK(exists(name));
+
+	//ͷh * w * elemSize˷0ʱͨ
+	{
+		int fd = shm_open(name.c_str(), O_RDWR, 0);
+		void *p = mmap(0, sizeof(_ShmHeader), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		close(fd);
+		_ShmHeader *hdr = static_cast<_ShmHeader *>(p);
+		unsigned long long h = hdr->h, w = hdr->w;
+		hdr->h = hdr->w = 1ull << 32;
+		bool broken = false;
+		try { SharedArray2D<int>::attach(name); }
+		catch (std::runtime_error &) { broken = true; }
+		ARR_CHECK(broken);
+		hdr->h = h;
+		hdr->w = w;
+		munmap(p, sizeof(_ShmHeader));
+	}
+	{
+		Array2D<int> x = SharedArray2D<int>::attach(name);
+		ARR_CHECK(x == src);
+	}
+	ARR_CHECK(SharedArray2D<int>::remove(name) && !exists(name));
+	bool missing = false;
+	try { SharedArray2D<int>::attach(name); }
+	catch (std::system_error &e) { missing = e.code().value() == ENOENT; }
+	ARR_CHECK(missing);
+	return 0;
+}
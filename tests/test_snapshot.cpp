@@ -0,0 +1,42 @@
+#include "array_snapshot.h"
+#include "test_util.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace arr;
+
+int main()
+{
+	typedef SquareMartrix<int> M;
+	SnapshotCell<M> cell(M(64, 0));
+	std::atomic<bool> stop(false);
+	std::atomic<long> reads(0);
+	std::atomic<bool> torn(false);
+	std::vector<std::thread> readers;
+	for (int t = 0; t != 4; t++)
+		readers.emplace_back([&]
+		{
+			while (!stop)
+			{
+				SnapshotCell<M>::Snapshot s = cell.acquire();
+				const M &m = *s;
+				int v = m[0][0];
+				for (size_t i = 0; i != 64; i++)
+					if (m[i][63 - i] != v)
+						torn = true;
+				if (m.hash() != M(64, v).hash())
+					torn = true;
+				reads++;
+			}
+		});
+	for (int g = 1; g != 500; g++)
+		cell.publish(M(64, g));
+	stop = true;
+	for (size_t t = 0; t != readers.size(); t++)
+		readers[t].join();
+	ARR_CHECK(!torn);
+	cell.reclaim();
+	ARR_CHECK((*cell.acquire())[5][5] == 499);
+	return 0;
+}
@@ -0,0 +1,65 @@
+#include "array_sort.h"
+#include "test_util.h"
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace arr;
+
+int main()
+{
+	std::mt19937 g(1);
+	size_t heights[] = { 1, 7, 300, 1000 };
+	for (size_t k = 0; k != 4; k++)
+	{
+		size_t h = heights[k], w = 257;
+		Array2D<int> a(h, w, 0);
+		for (Array2D<int>::iterator it = a.begin(); it != a.end(); ++it)
+			*it = g() % 1000;
+		const Array2D<int> &ca = a;
+		std::vector<int> ref(ca.begin(), ca.end());
+		std::sort(ref.begin(), ref.end());
+
+		Array2D<int> b(a);
+		parallelSort(b);
+		ARR_CHECK(std::equal(ref.begin(), ref.end(), static_cast<const Array2D<int> &>(b).begin()));
+
+		Array2D<int> c(a);
+		sortEachRow(c, std::greater<int>());
+		for (size_t i = 0; i != h; i++)
+			ARR_CHECK(std::is_sorted(c.row(i).begin(), c.row(i).end(), std::greater<int>()));
+
+		//0ֻмȡֵͬбԭ˳
+		Array2D<int> d(a);
+		for (size_t i = 0; i != h; i++)
+		{
+			d[i][0] = g() % 5;
+			d[i][1] = int(i);
+		}
+		sortRowsByColumn(d, 0);
+		for (size_t i = 1; i < h; i++)
+			ARR_CHECK(d[i - 1][0] < d[i][0] || (d[i - 1][0] == d[i][0] && d[i - 1][1] < d[i][1]));
+
+		Array2D<int> e(a);
+		for (size_t i = 0; i != h; i++)
+			e[i][0] = g() % 3;
+		sortRowsLexicographic(e);
+		for (size_t i = 1; i < h; i++)
+			ARR_CHECK(!std::lexicographical_compare(e.row(i).begin(), e.row(i).end(),
+				e.row(i - 1).begin(), e.row(i - 1).end()));
+	}
+
+	SquareMartrix<int> s(3, 0);
+	for (size_t i = 0; i != 3; i++)
+		s[i][0] = int(2 - i);
+	sortRowsByColumn(s, 0);
+	ARR_CHECK(s[0][0] == 0 && s[2][0] == 2);
+
+	//ֽܰڸƵԪ
+	std::string names[6] = { "c", "x", "a", "y", "b", "z" };
+	Array2D<std::string> t(3, 2, names, names + 6);
+	sortRowsByColumn(t, 0);
+	ARR_CHECK(t[0][0] == "a" && t[0][1] == "y" && t[2][0] == "c" && t[2][1] == "x");
+	return 0;
+}
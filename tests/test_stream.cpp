@@ -0,0 +1,72 @@
+#include "array_stream.h"
+#include "test_util.h"
+#include <cstdio>
+#include <vector>
+
+using namespace arr;
+
+template<class _Fn>
+static bool failsWithIo(_Fn f)
+{
+	try
+	{
+		f();
+	}
+	catch (std::ios_base::failure &)
+	{
+		return true;
+	}
+	return false;
+}
+
+int main(int argc, char *argv[])
+{
+	const char *path = argc > 1 ? argv[1] : "test_stream.bin";
+	{
+		Array2DWriter<int> w(path, 10, 3);
+		std::vector<int> v(30);
+		for (int i = 0; i != 30; i++)
+			v[i] = i;
+		w.write(v.data(), 4);
+		w.write(v.data() + 12, 6);
+		ARR_CHECK(failsWithIo([&] { w.write(v.data(), 1); }));
+		w.close();
+	}
+	{
+		Array2DReader<int> r(path);
+		ARR_CHECK(r.h() == 10 && r.w() == 3);
+		long sum = 0;
+		size_t rows = 0;
+		r.forEachBlock(4, [&](size_t row, size_t n, const int *d, size_t w)
+		{
+			ARR_CHECK(d[0] == int(row * 3));
+			for (size_t i = 0; i != n * w; i++)
+				sum += d[i];
+			rows += n;
+		});
+		ARR_CHECK(sum == 29 * 30 / 2 && rows == 10);
+	}
+	ARR_CHECK(failsWithIo([&] { Array2DReader<double> r(path); }));
+
+	{
+		Array2DWriter<int> w(path, 3, 3);
+		w.write(Array2D<int>(2, 3, 7));
+		ARR_CHECK(failsWithIo([&] { w.write(Array2D<int>(1, 1, 7)); }));
+		ARR_CHECK(failsWithIo([&] { w.close(); }));
+	}
+	ARR_CHECK(failsWithIo([&] { Array2DReader<int> r(path); }));
+
+	//ͷƵĴСԶļ
+	{
+		FILE *f = std::fopen(path, "wb");
+		unsigned long long head[3] = { 1ull << 62, 1ull << 62, sizeof(int) };
+		int x = 0;
+		std::fwrite(head, sizeof(head), 1, f);
+		std::fwrite(&x, sizeof(x), 1, f);
+		std::fclose(f);
+	}
+	ARR_CHECK(failsWithIo([&] { Array2DReader<int> r(path); }));
+	ARR_CHECK(failsWithIo([&] { Array2DReader<int> r("no/such/file.bin"); }));
+	std::remove(path);
+	return 0;
+}
@@ -0,0 +1,32 @@
+#include "array_tiled.h"
+#include "test_util.h"
+#include <vector>
+
+using namespace arr;
+
+int main()
+{
+	std::vector<int> d(100 * 100);
+	for (int i = 0; i != 10000; i++)
+		d[i] = i;
+	SquareMartrix<int> m(100, d.begin(), d.end());
+	TiledArray2D<int> t(m, 32);
+	ARR_CHECK(t.at(99, 99) == 9999 && t.at(40, 70) == 4070);
+
+	TiledArray2D<int> u(t);
+	ARR_CHECK(u.isTileShared(1, 2));
+	u.set(40, 70, -1);
+	ARR_CHECK(!u.isTileShared(1, 2) && u.isTileShared(0, 0));
+	ARR_CHECK(t.at(40, 70) == 4070 && u.at(40, 70) == -1);
+	std::vector<pair<size_t, size_t> > dirty = u.dirtyTiles();
+	ARR_CHECK(dirty.size() == 1 && dirty[0].first == 1 && dirty[0].second == 2);
+
+	SquareMartrix<int> o(100, 0), shared(o);
+	u.copyTo(o);
+	{
+		SquareMartrix<int> copy(o);
+		ARR_CHECK(copy.isShared());
+	}
+	ARR_CHECK(o[40][70] == -1 && o[99][98] == 9998 && shared[40][70] == 0);
+	return 0;
+}
@@ -0,0 +1,11 @@
+#ifndef ARRARY_TEST_UTIL
+#define ARRARY_TEST_UTIL
+
+#include <cstdio>
+#include <cstdlib>
+
+//assertNDEBUG»ʧκι¶Ҫ
+#define ARR_CHECK(cond) ((cond) ? (void)0 \
+	: (std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond), std::exit(1)))
+
+#endif // !ARRARY_TEST_UTIL
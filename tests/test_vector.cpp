@@ -0,0 +1,74 @@
+#include "array_vector.h"
+#include "test_util.h"
+#include <cmath>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace arr;
+
+template<class _Ty>
+static void check(size_t h, size_t w)
+{
+	Array2D<_Ty> a(h, w, from_generator, [](size_t i, size_t j) { return _Ty((i * 7 + j * 3) % 13) - _Ty(6); });
+	Array2D<_Ty> b(h, w, from_generator, [](size_t i, size_t j) { return _Ty((i + j * 5) % 9) - _Ty(4); });
+	const Array2D<_Ty> &ca = a, &cb = b;
+	std::vector<_Ty> x(w), xv(h), zr(w, _Ty());
+	for (size_t j = 0; j != w; j++)
+		x[j] = _Ty(j % 5) - _Ty(2);
+	for (size_t i = 0; i != h; i++)
+		xv[i] = _Ty(i % 3) - _Ty(1);
+
+	std::vector<_Ty> y = gemv(a, x), z = gevm(xv, a), d = rowDots(a, b);
+	for (size_t i = 0; i != h; i++)
+	{
+		_Ty s = 0, t = 0;
+		for (size_t j = 0; j != w; j++)
+		{
+			s += ca[i][j] * x[j];
+			t += ca[i][j] * cb[i][j];
+			zr[j] += xv[i] * ca[i][j];
+		}
+		ARR_CHECK(std::abs(double(s - y[i])) < 1e-6 && std::abs(double(t - d[i])) < 1e-6);
+	}
+	for (size_t j = 0; j != w; j++)
+		ARR_CHECK(std::abs(double(zr[j] - z[j])) < 1e-6);
+
+	StoreHint hints[] = { _CachedStore, _StreamingStore };
+	for (size_t k = 0; k != 2; k++)
+	{
+		Array2D<_Ty> r = broadcastRows(a, x, std::plus<_Ty>(), hints[k]);
+		Array2D<_Ty> c = broadcastColumns(a, xv, std::multiplies<_Ty>(), hints[k]);
+		const Array2D<_Ty> &cr = r, &cc = c;
+		for (size_t i = 0; i != h; i++)
+			for (size_t j = 0; j != w; j++)
+				ARR_CHECK(cr[i][j] == ca[i][j] + x[j] && cc[i][j] == ca[i][j] * xv[i]);
+	}
+
+	Array2D<_Ty> ip(a), ic(a);
+	broadcastRowsInPlace(ip, x, std::minus<_Ty>());
+	broadcastColumnsInPlace(ic, xv, std::plus<_Ty>());
+	const Array2D<_Ty> &cip = ip, &cic = ic;
+	for (size_t i = 0; i != h; i++)
+		for (size_t j = 0; j != w; j++)
+			ARR_CHECK(cip[i][j] == ca[i][j] - x[j] && cic[i][j] == ca[i][j] + xv[i]);
+	ARR_CHECK(ca[0][0] == _Ty(-6));
+}
+
+int main()
+{
+	size_t shapes[][2] = { { 1, 1 }, { 3, 7 }, { 129, 1 }, { 1, 1030 }, { 301, 257 }, { 700, 1500 } };
+	for (size_t k = 0; k != sizeof(shapes) / sizeof(shapes[0]); k++)
+	{
+		check<double>(shapes[k][0], shapes[k][1]);
+		check<float>(shapes[k][0], shapes[k][1]);
+		check<int>(shapes[k][0], shapes[k][1]);
+	}
+
+	//ֽܰڸƵԪغԷʱдʾ
+	Array2D<std::string> s(3, 4, std::string("x"));
+	std::vector<std::string> v(4, "y");
+	Array2D<std::string> r = broadcastRows(s, v, std::plus<std::string>(), _StreamingStore);
+	ARR_CHECK(static_cast<const Array2D<std::string> &>(r)[2][3] == "xy");
+	return 0;
+}